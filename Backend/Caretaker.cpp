@@ -1,15 +1,76 @@
 #include "Caretaker.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include "Serializer.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <iterator>
 
-Caretaker::Caretaker(const std::string& filename) : currentMemento(nullptr), saveFile(filename) 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// "auto<N>" names the autosave ring
+bool isAutosaveName(const std::string& name)
+{
+    return name.size() > 4 && name.compare(0, 4, "auto") == 0 &&
+           std::all_of(name.begin() + 4, name.end(), [](char c) { return std::isdigit((unsigned char)c); });
+}
+
+#ifndef _WIN32
+bool writeAll(int fd, const std::string& bytes)
+{
+    const char* data = bytes.data();
+    size_t left = bytes.size();
+    while (left > 0)
+    {
+        ssize_t written = write(fd, data, left);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        left -= (size_t)written;
+    }
+    return true;
+}
+#endif
+}
+
+Caretaker::Caretaker(const std::string& filename)
+    : currentMemento(nullptr), currentSavedAt(0), saveFile(filename), nextAutosave(0),
+      journalStarted(false), journalValid(false),
+      writing(false), stopping(false), status(SaveStatus::Idle), saveCount(0)
 {
     loadFromFile();
 }
 
 Caretaker::~Caretaker() 
 {
+    // Whatever is queued still gets written before we go
+    {
+        std::lock_guard<std::mutex> lock(saveMutex);
+        stopping = true;
+    }
+    saveWake.notify_all();
+    if (saveThread.joinable())
+        saveThread.join();
+
     if (currentMemento) 
     {
         delete currentMemento;
@@ -26,37 +87,622 @@ void Caretaker::addMemento(Memento* memento)
     }
     
     currentMemento = memento;
-    saveToFile();
+    currentSavedAt = (uint64_t)std::time(nullptr);
+
+    // The save thread gets its own copy: currentMemento may be replaced
+    // or deleted while the write is still running
+    queueSave(saveFile, new Memento(*memento));
+}
+
+bool Caretaker::saveToSlot(const std::string& name, Memento* memento)
+{
+    if (!memento) return false;
+
+    if (!isValidSlotName(name))
+    {
+        LOG_WARN("Caretaker: '%s' can't be used as a save slot name", name.c_str());
+        delete memento;
+        return false;
+    }
+
+    if (currentMemento)
+    {
+        delete currentMemento;
+    }
+    currentMemento = memento;
+    currentSavedAt = (uint64_t)std::time(nullptr);
+    queueSave(slotPath(name), new Memento(*memento));
+    return true;
+}
+
+void Caretaker::autosave(Memento* memento)
+{
+    if (!memento) return;
+
+    if (nextAutosave == 0)
+    {
+        // First autosave this session: carry on from the oldest file
+        nextAutosave = 1;
+        uint64_t oldest = UINT64_MAX;
+        for (int slot = 1; slot <= AUTOSAVE_SLOTS; slot++)
+        {
+            SaveSlotInfo info;
+            if (!readSummary(slotPath("auto" + std::to_string(slot)), info))
+            {
+                nextAutosave = slot; // free slot
+                break;
+            }
+            if (info.savedAt < oldest)
+            {
+                oldest = info.savedAt;
+                nextAutosave = slot;
+            }
+        }
+    }
+
+    queueSave(slotPath("auto" + std::to_string(nextAutosave)), memento, WriteKind::Checkpoint);
+    nextAutosave = nextAutosave % AUTOSAVE_SLOTS + 1;
+    journalStarted = true;
+}
+
+bool Caretaker::appendDelta(Memento* delta)
+{
+    if (!delta) return false;
+
+    // A delta means nothing without the checkpoint it follows
+    if (!journalStarted || !delta->isDelta())
+    {
+        delete delta;
+        return false;
+    }
+    queueSave(journalPath(), delta, WriteKind::Append);
+    return true;
+}
+
+std::string Caretaker::journalPath() const
+{
+    return std::filesystem::path(saveFile).replace_extension(".journal").string();
+}
+
+std::vector<Memento*> Caretaker::readJournal(uint32_t checkpointChecksum) const
+{
+    std::vector<Memento*> deltas;
+
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(journalPath())) return deltas;
+
+    BinaryReader in(file->data(), file->size());
+    if (in.readU32() != SaveFormat::JOURNAL_MAGIC)
+        return deltas;
+    in.readU16(); // version
+    in.readU16();
+    if (in.readU32() != checkpointChecksum || !in.ok())
+        return deltas;
+
+    while (in.remaining() >= 4)
+    {
+        uint32_t length = in.readU32();
+        if (length > in.remaining())
+            break; // torn append
+        BinaryReader record(in.position(), length);
+        in.skip(length);
+
+        BinaryReader magic = record;
+        Memento* delta = (magic.readU32() == SaveFormat::MAGIC) ? loadBinary(journalPath(), file, record, true) : nullptr;
+        if (!delta)
+            break;
+        deltas.push_back(delta);
+    }
+    return deltas;
+}
+
+std::string Caretaker::slotPath(const std::string& name) const
+{
+    if (name.empty())
+        return saveFile;
+
+    std::filesystem::path path(saveFile);
+    std::string stem = path.stem().string();
+    std::string extension = path.extension().string();
+
+    std::string file = isAutosaveName(name) ? stem + "." + name + extension : stem + "-" + name + extension;
+    return (path.parent_path() / file).string();
+}
+
+bool Caretaker::isValidSlotName(const std::string& name)
+{
+    if (name.empty() || name.size() > 32)
+        return false;
+    for (char c : name)
+    {
+        if (!std::isalnum((unsigned char)c) && c != '-' && c != '_')
+            return false;
+    }
+    return !isAutosaveName(name);
+}
+
+std::vector<SaveSlotInfo> Caretaker::listSlots() const
+{
+    std::vector<SaveSlotInfo> slots;
+
+    std::filesystem::path path(saveFile);
+    std::string fileName = path.filename().string();
+    std::string stem = path.stem().string();
+    std::string extension = path.extension().string();
+    std::filesystem::path dir = path.parent_path().empty() ? std::filesystem::path(".") : path.parent_path();
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, error))
+    {
+        std::string file = entry.path().filename().string();
+        if (file.size() < stem.size() + extension.size() ||
+            file.compare(file.size() - extension.size(), extension.size(), extension) != 0)
+            continue;
+
+        SaveSlotInfo info;
+        if (file == fileName)
+        {
+            info.name = "";
+        }
+        else if (file.compare(0, stem.size() + 1, stem + "-") == 0)
+        {
+            info.name = file.substr(stem.size() + 1, file.size() - stem.size() - 1 - extension.size());
+        }
+        else if (file.compare(0, stem.size() + 5, stem + ".auto") == 0)
+        {
+            info.name = file.substr(stem.size() + 1, file.size() - stem.size() - 1 - extension.size());
+            info.autosave = true;
+        }
+        else
+        {
+            continue;
+        }
+
+        info.path = entry.path().string();
+        if (readSummary(info.path, info))
+            slots.push_back(info);
+    }
+
+    std::sort(slots.begin(), slots.end(), [](const SaveSlotInfo& a, const SaveSlotInfo& b) {
+        if (a.savedAt != b.savedAt)
+            return a.savedAt > b.savedAt;
+        return a.name < b.name;
+    });
+    return slots;
+}
+
+bool Caretaker::readSummary(const std::string& path, SaveSlotInfo& info) const
+{
+    // Enough for a summary, or for the meta section right after an old header
+    const size_t prefixSize = SaveFormat::PREAMBLE_SIZE + 6 + 20;
+    char prefix[prefixSize > SaveFormat::HEADER_SIZE ? prefixSize : SaveFormat::HEADER_SIZE];
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    file.read(prefix, sizeof(prefix));
+
+    BinaryReader in(prefix, (size_t)file.gcount());
+    if (in.readU32() != SaveFormat::MAGIC)
+        return false;
+    uint16_t version = in.readU16();
+    in.readU16(); // section count
+
+    if (version >= SaveFormat::FIRST_VERSION_WITH_SUMMARY)
+    {
+        info.checksum = in.readU32();
+        info.savedAt = in.readU64();
+        info.day = in.readI32();
+        info.hour = in.readU8();
+        info.minute = in.readU8();
+        info.plants = in.readU16();
+        info.money = in.readF32();
+        return in.ok();
+    }
+
+    // Version 1: no summary, but the meta section always came first
+    uint16_t id;
+    BinaryReader body;
+    if (!in.nextSection(id, body) || id != SaveFormat::SECTION_META)
+        return false;
+    info.money = body.readF32();
+    body.readI32(); // rating
+    info.day = body.readI32();
+    info.hour = body.readI32();
+    info.minute = body.readI32();
+    return body.ok();
+}
+
+void Caretaker::queueSave(const std::string& path, Memento* memento, WriteKind kind)
+{
+    {
+        std::lock_guard<std::mutex> lock(saveMutex);
+        bool replaced = false;
+        for (PendingSave& save : pending)
+        {
+            if (kind == WriteKind::Replace && save.kind == WriteKind::Replace && save.path == path)
+            {
+                delete save.memento; // superseded before it was written
+                save.memento = memento;
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced)
+            pending.push_back({path, memento, kind});
+
+        status = SaveStatus::Saving;
+        if (!saveThread.joinable())
+            saveThread = std::thread(&Caretaker::saveLoop, this);
+    }
+    saveWake.notify_one();
+}
+
+uint64_t Caretaker::getSavedAt() const
+{
+    return currentSavedAt;
 }
 
 Memento* Caretaker::getMemento() const 
 {
+    // The main save is mapped at startup without reading it through; its
+    // checksum is checked the first time someone actually wants the state
+    if (currentMemento && !currentMemento->verify())
+    {
+        LOG_WARN("Caretaker: %s failed its checksum", saveFile.c_str());
+        return nullptr;
+    }
     return currentMemento;
 }
 
-void Caretaker::saveToFile() 
+void Caretaker::waitForSave()
 {
-    if (!currentMemento) return;
-    
-    std::ofstream file(saveFile);
-    if (!file.is_open()) return;
-    
-    file << "INVENTORY:" << currentMemento->getInventoryData() << "\n";
-    file << "GREENHOUSE:" << currentMemento->getGreenhouseData() << "\n";
-    file << "WORKERS:" << currentMemento->getWorkerData() << "\n";
-    file << "MONEY:" << currentMemento->getMoney() << "\n";
-    file << "RATING:" << currentMemento->getRating() << "\n";
-    file << "DAY:" << currentMemento->getDay() << "\n";
-    file << "HOUR:" << currentMemento->getHour() << "\n";
-    file << "MINUTE:" << currentMemento->getMinute() << "\n";
-    
-    file.close();
+    std::unique_lock<std::mutex> lock(saveMutex);
+    saveIdle.wait(lock, [this] { return pending.empty() && !writing; });
+}
+
+SaveStatus Caretaker::getSaveStatus() const
+{
+    return status;
+}
+
+unsigned int Caretaker::getSaveCount() const
+{
+    return saveCount;
+}
+
+void Caretaker::saveLoop()
+{
+    std::unique_lock<std::mutex> lock(saveMutex);
+    while (true)
+    {
+        saveWake.wait(lock, [this] { return !pending.empty() || stopping; });
+        if (pending.empty())
+            break; // stopping with nothing left to write
+
+        PendingSave save = pending.front();
+        pending.erase(pending.begin());
+        writing = true;
+        lock.unlock();
+
+        bool ok = runWrite(save);
+        delete save.memento;
+
+        lock.lock();
+        writing = false;
+        // A newer save queued meanwhile keeps the status at Saving
+        if (pending.empty())
+            status = ok ? SaveStatus::Saved : SaveStatus::Failed;
+        saveCount++;
+        saveIdle.notify_all();
+    }
+}
+
+bool Caretaker::runWrite(const PendingSave& save)
+{
+    std::string bytes = encode(*save.memento);
+
+    if (save.kind == WriteKind::Append)
+    {
+        // Deltas after a failed checkpoint would be replayed onto the wrong base
+        if (!journalValid)
+            return false;
+
+        BinaryWriter record(4 + bytes.size());
+        record.writeU32((uint32_t)bytes.size());
+        record.writeBytes(bytes.data(), bytes.size());
+        return appendToFile(save.path, record.getData());
+    }
+
+    bool ok = writeFileAtomically(save.path, bytes);
+    if (save.kind == WriteKind::Checkpoint)
+    {
+        journalValid = false;
+        if (ok)
+        {
+            BinaryReader summary(bytes.data() + SaveFormat::PREAMBLE_SIZE, 4);
+            BinaryWriter header(SaveFormat::JOURNAL_HEADER_SIZE);
+            header.writeU32(SaveFormat::JOURNAL_MAGIC);
+            header.writeU16(SaveFormat::VERSION);
+            header.writeU16(0);
+            header.writeU32(summary.readU32()); // the checkpoint's checksum
+            journalValid = writeFileAtomically(journalPath(), header.getData());
+        }
+    }
+    return ok;
+}
+
+bool Caretaker::writeFileAtomically(const std::string& path, const std::string& bytes)
+{
+    const std::string tempPath = path + ".tmp";
+
+#ifdef _WIN32
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (!file)
+    {
+        LOG_WARN("Caretaker: can't create %s: %s", tempPath.c_str(), strerror(errno));
+        return false;
+    }
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() &&
+              fflush(file) == 0 && _commit(_fileno(file)) == 0;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok || !MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        LOG_WARN("Caretaker: writing %s failed", path.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+#else
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        LOG_WARN("Caretaker: can't create %s: %s", tempPath.c_str(), strerror(errno));
+        return false;
+    }
+
+    bool ok = writeAll(fd, bytes) && fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+
+    if (!ok || rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        LOG_WARN("Caretaker: writing %s failed: %s", path.c_str(), strerror(errno));
+        unlink(tempPath.c_str());
+        return false;
+    }
+
+    // Make the rename itself durable
+    std::string dir = std::filesystem::path(path).parent_path().string();
+    int dirFd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (dirFd >= 0)
+    {
+        fsync(dirFd);
+        close(dirFd);
+    }
+    return true;
+#endif
+}
+
+bool Caretaker::appendToFile(const std::string& path, const std::string& bytes)
+{
+#ifdef _WIN32
+    FILE* file = fopen(path.c_str(), "ab");
+    if (!file)
+    {
+        LOG_WARN("Caretaker: can't open %s: %s", path.c_str(), strerror(errno));
+        return false;
+    }
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() &&
+              fflush(file) == 0 && _commit(_fileno(file)) == 0;
+    ok = (fclose(file) == 0) && ok;
+#else
+    int fd = open(path.c_str(), O_WRONLY | O_APPEND);
+    if (fd < 0)
+    {
+        LOG_WARN("Caretaker: can't open %s: %s", path.c_str(), strerror(errno));
+        return false;
+    }
+    bool ok = writeAll(fd, bytes) && fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+#endif
+    if (!ok)
+    {
+        LOG_WARN("Caretaker: appending to %s failed", path.c_str());
+    }
+    return ok;
+}
+
+std::string Caretaker::encode(const Memento& m) const
+{
+    BinaryReader inventory = m.readInventory();
+    BinaryReader greenhouse = m.readGreenhouse();
+    BinaryReader workers = m.readWorkers();
+    BinaryWriter out(64 + inventory.remaining() + greenhouse.remaining() + workers.remaining());
+
+    // A memento loaded from an older binary save still has that save's
+    // payloads, so label it as such (v1 payloads are the same as v2)
+    uint16_t version = SaveFormat::VERSION;
+    if (m.getFormat() != SaveFormat::LEGACY_TEXT && m.getFormat() < SaveFormat::VERSION)
+        version = (uint16_t)std::max(m.getFormat(), (int)SaveFormat::FIRST_VERSION_WITH_SUMMARY);
+
+    out.writeU32(SaveFormat::MAGIC);
+    out.writeU16(version);
+    out.writeU16(m.isDelta() ? 5 : 4); // sections
+
+    // Summary; the checksum is patched in once the sections are written
+    out.writeU32(0);
+    out.writeU64((uint64_t)std::time(nullptr));
+    out.writeI32(m.getDay());
+    out.writeU8((uint8_t)m.getHour());
+    out.writeU8((uint8_t)m.getMinute());
+    out.writeU16((uint16_t)(m.getFormat() == SaveFormat::LEGACY_TEXT ? 0 : Serializer::countGreenhousePlants(greenhouse)));
+    out.writeF32(m.getMoney());
+
+    size_t section = out.beginSection(SaveFormat::SECTION_META);
+    out.writeF32(m.getMoney());
+    out.writeI32(m.getRating());
+    out.writeI32(m.getDay());
+    out.writeI32(m.getHour());
+    out.writeI32(m.getMinute());
+    out.endSection(section);
+
+    section = out.beginSection(SaveFormat::SECTION_INVENTORY);
+    out.writeBytes(inventory.position(), inventory.remaining());
+    out.endSection(section);
+
+    section = out.beginSection(SaveFormat::SECTION_GREENHOUSE);
+    out.writeBytes(greenhouse.position(), greenhouse.remaining());
+    out.endSection(section);
+
+    section = out.beginSection(SaveFormat::SECTION_WORKERS);
+    out.writeBytes(workers.position(), workers.remaining());
+    out.endSection(section);
+
+    if (m.isDelta())
+    {
+        out.endSection(out.beginSection(SaveFormat::SECTION_DELTA));
+    }
+
+    const std::string& data = out.getData();
+    out.patchU32(SaveFormat::PREAMBLE_SIZE,
+                 SaveFormat::crc32(data.data() + SaveFormat::HEADER_SIZE, data.size() - SaveFormat::HEADER_SIZE));
+    return out.release();
 }
 
 void Caretaker::loadFromFile() 
 {
-    std::ifstream file(saveFile);
-    if (!file.is_open()) return;
+    // Saves from before the binary format were text files next to it
+    std::string path = saveFile;
+    std::error_code error;
+    if (!std::filesystem::exists(path, error))
+    {
+        path = std::filesystem::path(saveFile).replace_extension(".txt").string();
+    }
+
+    // Only the header and section table are read here
+    Memento* memento = readSave(path, false);
+    if (memento)
+    {
+        currentMemento = memento;
+        SaveSlotInfo info;
+        currentSavedAt = readSummary(path, info) ? info.savedAt : 0;
+    }
+}
+
+bool Caretaker::loadSlot(const std::string& name)
+{
+    // A queued write to this slot should land before we read it back
+    waitForSave();
+
+    Memento* memento = readSave(slotPath(name), true);
+    if (!memento)
+        return false;
+
+    if (currentMemento)
+    {
+        delete currentMemento;
+    }
+    currentMemento = memento;
+    SaveSlotInfo info;
+    currentSavedAt = readSummary(slotPath(name), info) ? info.savedAt : 0;
+    return true;
+}
+
+Memento* Caretaker::readSave(const std::string& path, bool checkNow) const
+{
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path)) return nullptr;
+
+    BinaryReader contents(file->data(), file->size());
+    BinaryReader magic = contents;
+    if (magic.readU32() == SaveFormat::MAGIC)
+    {
+        return loadBinary(path, file, contents, checkNow);
+    }
+    return loadText(std::string(file->data(), file->size()));
+}
+
+Memento* Caretaker::loadBinary(const std::string& path, std::shared_ptr<const MappedFile> file,
+                               BinaryReader contents, bool checkNow) const
+{
+    BinaryReader in = contents;
+    in.readU32(); // magic
+    uint16_t version = in.readU16();
+    in.readU16(); // section count, informational
+    if (!in.ok() || version == 0 || version > SaveFormat::VERSION)
+    {
+        LOG_WARN("Caretaker: %s has unsupported save version %u", path.c_str(), (unsigned)version);
+        return nullptr;
+    }
+
+    bool hasChecksum = version >= SaveFormat::FIRST_VERSION_WITH_SUMMARY;
+    uint32_t checksum = 0;
+    if (hasChecksum)
+    {
+        checksum = in.readU32();
+        in.skip(SaveFormat::SUMMARY_SIZE - 4);
+    }
+
+    BinaryReader inv, gh, workers;   // views into the mapping, nothing copied
+    float money = 0.0f;
+    int rating = 0, day = 1, hour = 6, minute = 0;
+    bool haveMeta = false;
+    bool delta = false;
+
+    uint16_t id;
+    BinaryReader body;
+    while (in.nextSection(id, body))
+    {
+        switch (id)
+        {
+        case SaveFormat::SECTION_META:
+            money = body.readF32();
+            rating = body.readI32();
+            day = body.readI32();
+            hour = body.readI32();
+            minute = body.readI32();
+            haveMeta = body.ok();
+            break;
+        case SaveFormat::SECTION_INVENTORY:
+            inv = body;
+            break;
+        case SaveFormat::SECTION_GREENHOUSE:
+            gh = body;
+            break;
+        case SaveFormat::SECTION_WORKERS:
+            workers = body;
+            break;
+        case SaveFormat::SECTION_DELTA:
+            delta = true;
+            break;
+        default:
+            break; // newer section this build doesn't know about
+        }
+    }
+
+    if (!haveMeta)
+    {
+        LOG_WARN("Caretaker: %s is truncated or corrupt", path.c_str());
+        return nullptr;
+    }
+    Memento* memento = new Memento(file, inv, workers, gh, money, rating, day, hour, minute, version, delta);
+    if (hasChecksum)
+    {
+        BinaryReader checked = contents;
+        checked.skip(SaveFormat::HEADER_SIZE);
+        memento->deferChecksum(checked, checksum);
+        if (checkNow && !memento->verify())
+        {
+            LOG_WARN("Caretaker: %s failed its checksum", path.c_str());
+            delete memento;
+            return nullptr;
+        }
+    }
+    return memento;
+}
+
+Memento* Caretaker::loadText(const std::string& contents) const
+{
+    std::istringstream file(contents);
     
     std::string line;
     std::string inv, gh, workers;
@@ -97,21 +743,24 @@ void Caretaker::loadFromFile()
         }
     }
     
-    file.close();
-    
     if (!inv.empty() || !gh.empty() || !workers.empty()) 
     {
-        currentMemento = new Memento(inv, workers, gh, money, rating, day, hour, minute);
+        return new Memento(inv, workers, gh, money, rating, day, hour, minute, SaveFormat::LEGACY_TEXT);
     }
+    return nullptr;
 }
 
 void Caretaker::deleteData() 
 {
+    // Don't let a queued write bring the file back afterwards
+    waitForSave();
+
     if (currentMemento) 
     {
         delete currentMemento;
         currentMemento = nullptr;
     }
+    currentSavedAt = 0;
     
     try 
     {
@@ -1,29 +1,155 @@
 #pragma once
 
 #include "Memento.h"
+#include "SaveFormat.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
+class MappedFile;
+
+enum class SaveStatus : uint8_t
+{
+    Idle,     // nothing saved yet this session
+    Saving,   // a write is queued or in progress
+    Saved,    // last write reached the disk
+    Failed    // last write failed; the previous file is untouched
+};
+
+// What a load menu shows for one save file, read from its header only
+struct SaveSlotInfo
+{
+    std::string name;       // "" for the main save, a slot name, or "auto<N>"
+    std::string path;
+    bool autosave = false;
+    uint64_t savedAt = 0;   // unix seconds, 0 for files older than the summary
+    int day = 0;
+    int hour = 0;
+    int minute = 0;
+    float money = 0.0f;
+    int plants = -1;        // -1 when the file has no summary
+    uint32_t checksum = 0;
+};
+
+// Save files all live next to the main one:
+//   game_state.sav          main save (addMemento / loadFromFile)
+//   game_state-<name>.sav   named slots
+//   game_state.auto<N>.sav  autosave ring, N = 1..AUTOSAVE_SLOTS
+//   game_state.journal      deltas since the newest autosave checkpoint
 class Caretaker {
 private:
     Memento* currentMemento;
+    uint64_t currentSavedAt;   // unix seconds
     std::string saveFile;
 
 public:
-    Caretaker(const std::string& filename = "game_state.txt");
+    static constexpr int AUTOSAVE_SLOTS = 5;
+
+    Caretaker(const std::string& filename = "game_state.sav");
     ~Caretaker();
 
-    // Add memento - automatically saves to file
+    // Keeps the memento as the current one and queues it to be written to
+    // disk on the save thread; returns without touching the file system.
+    // If saves come in faster than the disk, only the newest is written.
     void addMemento(Memento* memento);
-    
+
+    // Same as addMemento but into a named slot (letters, digits, '-' and '_').
+    // Returns false and deletes the memento if the name is not usable.
+    bool saveToSlot(const std::string& name, Memento* memento);
+
+    // Writes a full checkpoint into the oldest autosave file of the ring and
+    // starts a new journal after it. Doesn't change the current memento, so
+    // "load" still means the last manual save.
+    void autosave(Memento* memento);
+
+    // Appends a delta memento to the journal of the last checkpoint. Cheap:
+    // only the changed plots/slots are written, and nothing is rewritten.
+    // Returns false (and deletes it) if no checkpoint was made this session.
+    bool appendDelta(Memento* delta);
+
+    // The deltas recorded after the checkpoint with this checksum, oldest
+    // first, up to the first damaged record. Empty if the journal belongs
+    // to another checkpoint. Caller deletes them.
+    std::vector<Memento*> readJournal(uint32_t checkpointChecksum) const;
+    std::string journalPath() const;
+
     // Get current memento
     Memento* getMemento() const;
-    
-    // Load from file
+    // When the current memento was saved (unix seconds), 0 if unknown
+    uint64_t getSavedAt() const;
+
+    // Load from file (binary save, or an old text save with the same name and .txt).
+    // Binary saves are memory-mapped and stay on disk until something reads
+    // the state, so this is cheap however big the save is.
     void loadFromFile();
-    
+
+    // Makes the given slot ("" for the main save, "auto<N>" for autosaves)
+    // the current memento. False if it is missing or fails its checksum.
+    bool loadSlot(const std::string& name);
+
+    // Every save file, newest first. Reads only the header of each file.
+    std::vector<SaveSlotInfo> listSlots() const;
+    std::string slotPath(const std::string& name) const;
+
     // Delete all saved data from file
     void deleteData();
 
+    // Blocks until every queued write has finished
+    void waitForSave();
+    SaveStatus getSaveStatus() const;
+    // Bumped after each finished write, so the UI can spot a new result
+    unsigned int getSaveCount() const;
+
 private:
-    void saveToFile();
-};
\ No newline at end of file
+    enum class WriteKind : uint8_t
+    {
+        Replace,      // atomic rewrite; a newer one for the same file wins
+        Checkpoint,   // Replace, then start a fresh journal after it
+        Append        // journal record, never dropped or merged
+    };
+
+    struct PendingSave
+    {
+        std::string path;
+        Memento* memento;
+        WriteKind kind;
+    };
+
+    // Binary layout: see SaveFormat.h
+    std::string encode(const Memento& memento) const;
+    // checkNow=false defers the checksum to Memento::verify(), so opening
+    // a save only touches its header and section table
+    Memento* readSave(const std::string& path, bool checkNow) const;
+    Memento* loadBinary(const std::string& path, std::shared_ptr<const MappedFile> file,
+                        BinaryReader contents, bool checkNow) const;
+    Memento* loadText(const std::string& contents) const;
+    bool readSummary(const std::string& path, SaveSlotInfo& info) const;
+    static bool isValidSlotName(const std::string& name);
+
+    void queueSave(const std::string& path, Memento* memento, WriteKind kind = WriteKind::Replace);
+    bool runWrite(const PendingSave& save);
+    void saveLoop();
+    // Write to a temp file, fsync, then rename over the target, so a crash
+    // leaves either the old save or the new one, never half of one
+    static bool writeFileAtomically(const std::string& path, const std::string& bytes);
+    static bool appendToFile(const std::string& path, const std::string& bytes);
+
+    int nextAutosave;           // 1-based ring position, 0 until first autosave
+    bool journalStarted;        // a checkpoint was queued this session
+    bool journalValid;          // save thread: journal matches the last checkpoint
+
+    std::thread saveThread;     // started on the first save
+    std::mutex saveMutex;
+    std::condition_variable saveWake;
+    std::condition_variable saveIdle;
+    std::vector<PendingSave> pending;   // FIFO (guarded by saveMutex)
+    bool writing;               // save thread busy with a write (guarded by saveMutex)
+    bool stopping;
+    std::atomic<SaveStatus> status;
+    std::atomic<unsigned int> saveCount;
+};
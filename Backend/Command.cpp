@@ -1,72 +1,89 @@
 #include "Command.h"
 #include "Player.h"
 #include "Game.h"
-#include <iostream>
+#include "Logger.h"
 
+// Sized for the plot commands, the ones made in bulk
+typedef BlockPool<Command, sizeof(WaterCommand)> CommandPool;
+
+void* Command::operator new(size_t size)
+{
+    return CommandPool::allocate(size);
+}
+
+void Command::operator delete(void* p, size_t size)
+{
+    CommandPool::deallocate(p, size);
+}
+
+PoolStats Command::poolStats()
+{
+    return CommandPool::stats();
+}
+
+
+WaterCommand::WaterCommand(PlotHandle plot, Greenhouse *gh)
+: target(plot), subject(gh)
+{
+}
 
 WaterCommand::WaterCommand(Plant *plant, Greenhouse *gh)
-: targetPlant(plant), subject(gh)
+: target(gh ? gh->getHandle(plant) : PlotHandle()), subject(gh)
 {
 }
 
 
+FertilizeCommand::FertilizeCommand(PlotHandle plot, Greenhouse *gh)
+: target(plot), subject(gh)
+{
+}
+
 FertilizeCommand::FertilizeCommand(Plant *plant, Greenhouse *gh)
-: targetPlant(plant), subject(gh)
+: target(gh ? gh->getHandle(plant) : PlotHandle()), subject(gh)
 {
 }
 
 
+HarvestCommand::HarvestCommand(PlotHandle plot, Greenhouse* gh)
+: target(plot), subject(gh)
+{
+}
+
 HarvestCommand::HarvestCommand(Plant* plant, Greenhouse* gh)
-: targetPlant(plant), subject(gh)
+: target(gh ? gh->getHandle(plant) : PlotHandle()), subject(gh)
 {
 }
 
 void WaterCommand::execute()
 {
-    if (!targetPlant) return;
-
-    if (!subject || subject->getPlantByPointer(targetPlant) == nullptr) {
-        return; 
-    }
-
-    if (targetPlant->isDead()) {
-        return;
-    }
-    
-    std::cout << "COMMAND EXECUTION: WaterCommand started. Target water: " 
-              << this->targetPlant->getWater() << "%." << std::endl;
-    this->targetPlant->water(50.0f);
-    std::cout << "COMMAND EXECUTION: WaterCommand completed. New water: " 
-              << this->targetPlant->getWater() << "%." << std::endl;
+    if (!subject) return;
 
+    // Does nothing if the handle went stale (plant harvested or replaced
+    // since this was queued); the plot stays locked while we water it
+    subject->withPlant(target, [](Plant* targetPlant) {
+        if (targetPlant->isDead()) {
+            return;
+        }
+        float before = targetPlant->getWater();
+        targetPlant->water(50.0f);
+        LOG_DEBUG("WaterCommand: water %.1f%% -> %.1f%%", before, targetPlant->getWater());
+    });
 }
 void FertilizeCommand::execute()
 {
-    
-    if (!targetPlant) return;
-    if (!subject || subject->getPlantByPointer(targetPlant) == nullptr) {
-        return; 
-    }
-    if (targetPlant->isDead()) {
-        return;
-    }
-    this->targetPlant->fertilize(50.0f);
+    if (!subject) return;
+
+    subject->withPlant(target, [](Plant* targetPlant) {
+        if (!targetPlant->isDead()) {
+            targetPlant->fertilize(50.0f);
+        }
+    });
 }
 void HarvestCommand::execute()
 {
-    if (!targetPlant) return;
-    if (!subject || subject->getPlantByPointer(targetPlant) == nullptr) {
-        return; 
-    }
-
-    Game* game= Game::getInstance();
-    Player* player= game->getPlayerPtr();
-
-    if(player){
-    Greenhouse* greenhouse= player->getPlot();
-    if(greenhouse)
-   greenhouse->harvestPlant(targetPlant);
-    }
+    if (!subject) return;
+
+    subject->harvestPlant(target);
 }
 void PatrolCommand::execute()
 { Player* player=Game::getInstance()->getPlayerPtr();
@@ -1,4 +1,5 @@
 #pragma once
+#include "ObjectPool.h"
 #include "Plant.h"
 #include "Customer.h"
 #include "Greenhouse.h"
@@ -6,6 +7,13 @@
 class Command {
 public:
     virtual ~Command() {}
+
+    // Workers make one per plot event and a pool thread frees it as soon
+    // as it has run, so commands live in a BlockPool rather than the heap
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+    static PoolStats poolStats();
+
     virtual void execute() = 0;
     virtual bool isPatrol() const { return false; }
 };
@@ -13,9 +21,10 @@ public:
 class WaterCommand : public Command {
 public:
     void execute() override;
+    WaterCommand(PlotHandle plot, Greenhouse* gh);
     WaterCommand(Plant* plant, Greenhouse* gh); 
 private:
-    Plant* targetPlant;
+    PlotHandle target;   // resolved on execute, so a replaced plant is never touched
     Greenhouse* subject; 
 };
 
@@ -23,18 +32,21 @@ class FertilizeCommand : public Command {
 public:
     void execute() override;
    
+    FertilizeCommand(PlotHandle plot, Greenhouse* gh);
+   
     FertilizeCommand(Plant* plant, Greenhouse* gh);
 private:
-    Plant* targetPlant;
+    PlotHandle target;   // resolved on execute, so a replaced plant is never touched
     Greenhouse* subject; 
 };
 
 class HarvestCommand : public Command {
 public:
     void execute() override;
+    HarvestCommand(PlotHandle plot, Greenhouse* gh);
     HarvestCommand(Plant* plant, Greenhouse* gh);
 private:
-    Plant* targetPlant;
+    PlotHandle target;   // resolved on execute, so a replaced plant is never touched
     Greenhouse* subject;
 };
 
@@ -1,8 +1,10 @@
 #include "Game.h"
+#include <algorithm>
+#include <ctime>
 
 Game *Game::uniqueInstance = nullptr;
 
-Game::Game() : player(), caretaker("game_state.txt") {}
+Game::Game() : player(), caretaker("game_state.sav"), simulation(&player), lastAutosaveMinute(-1), autosavesSinceCheckpoint(0) {}
 Game::~Game() {}
 Game *Game::getInstance()
 {
@@ -12,6 +14,11 @@ Game *Game::getInstance()
     }
     return uniqueInstance;
 }
+void Game::cleanup()
+{
+    delete uniqueInstance;
+    uniqueInstance = nullptr;
+}
 Player &Game::getPlayer()
 {
     return player;
@@ -20,6 +27,10 @@ Player *Game::getPlayerPtr()
 {
     return &player;
 }
+SimulationEngine &Game::getSimulation()
+{
+    return simulation;
+}
 
 void Game::saveGame()
 {
@@ -36,5 +47,99 @@ void Game::loadGame()
     if (memento)
     {
         player.setMemento(memento);
+        autosavesSinceCheckpoint = 0;
+        catchUpOffline(caretaker.getSavedAt());
+        return;
+    }
+
+    // Never saved by hand (or the save is gone): fall back to the newest autosave
+    for (const SaveSlotInfo &slot : caretaker.listSlots())
+    {
+        if (slot.autosave && loadSlot(slot.name))
+        {
+            return;
+        }
+    }
+}
+
+SaveStatus Game::getSaveStatus() const
+{
+    return caretaker.getSaveStatus();
+}
+
+bool Game::saveToSlot(const std::string &name)
+{
+    return caretaker.saveToSlot(name, player.createMemento());
+}
+
+bool Game::loadSlot(const std::string &name)
+{
+    if (!caretaker.loadSlot(name))
+    {
+        return false;
+    }
+    player.setMemento(caretaker.getMemento());
+
+    // An autosave checkpoint may have a journal of hourly deltas after it
+    for (const SaveSlotInfo &slot : caretaker.listSlots())
+    {
+        if (slot.name == name && slot.autosave)
+        {
+            for (Memento *delta : caretaker.readJournal(slot.checksum))
+            {
+                player.setMemento(delta);
+                delete delta;
+            }
+            break;
+        }
+    }
+
+    // The next autosave has to be a checkpoint of what was just loaded
+    autosavesSinceCheckpoint = 0;
+    // Journal deltas are at most a checkpoint interval newer than the
+    // checkpoint's timestamp, which is close enough here
+    catchUpOffline(caretaker.getSavedAt());
+    return true;
+}
+
+void Game::catchUpOffline(uint64_t savedAt)
+{
+    const uint64_t now = (uint64_t)std::time(nullptr);
+    if (savedAt == 0 || now < savedAt + MIN_OFFLINE_SECONDS)
+    {
+        return;
+    }
+    const uint64_t minutes = std::min<uint64_t>(now - savedAt, MAX_OFFLINE_MINUTES);
+    simulation.fastForward((long long)minutes);
+}
+
+std::vector<SaveSlotInfo> Game::listSaves() const
+{
+    return caretaker.listSlots();
+}
+
+void Game::autosaveIfDue()
+{
+    long long now = ((long long)player.getDay() * 24 + player.getHour()) * 60 + player.getMinute();
+    if (lastAutosaveMinute < 0 || now < lastAutosaveMinute)
+    {
+        // First frame, or the clock was set back by a load
+        lastAutosaveMinute = now;
+        return;
+    }
+    if (now - lastAutosaveMinute >= AUTOSAVE_INTERVAL_MINUTES)
+    {
+        // Mostly small deltas; a full checkpoint now and then bounds how
+        // many have to be replayed on load
+        if (autosavesSinceCheckpoint == 0)
+        {
+            caretaker.autosave(player.createCheckpoint());
+        }
+        else
+        {
+            caretaker.appendDelta(player.createDeltaMemento());
+        }
+        autosavesSinceCheckpoint = (autosavesSinceCheckpoint + 1) % CHECKPOINT_EVERY;
+        lastAutosaveMinute = now;
     }
 }
\ No newline at end of file
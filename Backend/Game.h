@@ -2,21 +2,50 @@
 
 #include "Player.h"
 #include "Caretaker.h"
+#include "SimulationEngine.h"
 
 class Game {
 private:
     static Game* uniqueInstance;
     Player player;
     Caretaker caretaker; 
+    SimulationEngine simulation;
+    long long lastAutosaveMinute;   // game clock at the last autosave, -1 before the first check
+    int autosavesSinceCheckpoint;   // 0: the next autosave is a full checkpoint
 
 public:
     Game();
     ~Game();
     static Game* getInstance();
+    static void cleanup();
     Player& getPlayer();
     Player* getPlayerPtr();
+    SimulationEngine& getSimulation();
 
+    // Snapshots on the calling thread, writes the file in the background
     void saveGame();
     void loadGame();
+    SaveStatus getSaveStatus() const;
+
+    // Named slots and the autosave ring (see Caretaker)
+    bool saveToSlot(const std::string& name);
+    bool loadSlot(const std::string& name);
+    std::vector<SaveSlotInfo> listSaves() const;
+
+    // Call once per frame after the simulation: autosaves every
+    // AUTOSAVE_INTERVAL_MINUTES of game time, as a delta of what changed
+    // except every CHECKPOINT_EVERY-th, which is a full checkpoint
+    void autosaveIfDue();
+    static const int AUTOSAVE_INTERVAL_MINUTES = 60;
+    static const int CHECKPOINT_EVERY = 6;
+
+    // Loading a save plays the real time since it was written as game time
+    // (a real second per game minute, as in the daytime), fast-forwarded.
+    // Quick save/load round trips are left alone, and long absences are capped.
+    static const int MIN_OFFLINE_SECONDS = 60;
+    static const int MAX_OFFLINE_MINUTES = 12 * 60;
+
+private:
+    void catchUpOffline(uint64_t savedAt);
 };
 
@@ -1,47 +1,62 @@
 #include "Greenhouse.h"
+#include <algorithm>
+#include <climits>
 #include <iostream>
 
 Greenhouse::Greenhouse()
 {
     size=0;
-    capacity=56;
-    plots.resize(capacity,nullptr);
+    capacity=0;
+    for(auto& chunk : chunks){
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    growTo(56);
     inventory=nullptr;
 }
 
-Greenhouse::Greenhouse(Inventory *inv)
+Greenhouse::Greenhouse(Inventory *inv) : Greenhouse()
 {
-    size = 0;
-    capacity = 56;
-    plots.resize(capacity, nullptr);
     inventory = inv;
 }
 
 Greenhouse::~Greenhouse()
 {
-    for(auto plant : plots){
-        if(plant){
-            delete plant;
+    for(auto& chunk : chunks){
+        PlotChunk* plotChunk = chunk.load(std::memory_order_relaxed);
+        if(plotChunk == nullptr){
+            continue;
+        }
+        for(auto plant : plotChunk->plots){
+            if(plant){
+                delete plant;
+            }
         }
+        delete plotChunk;
     }
 }
 
 bool Greenhouse::addPlant(Plant* plant, int position)
 {
-    if(position >= 0 && position < capacity && plots[position] == nullptr){
-        plots[position] = plant;
-        size++;
-        return true;
+    if(plant == nullptr || !inRange(position)){
+        return false;
     }
-    return false;
+    std::lock_guard<std::mutex> lock(stripeFor(position));
+    if(plotAt(position) != nullptr){
+        return false;
+    }
+    place(position, plant);
+    return true;
 }
 
 bool Greenhouse::addPlant(Plant *plant)
 {
+    if(plant == nullptr){
+        return false;
+    }
     for(int i = 0; i < capacity; i++){
-        if(plots[i] == nullptr){
-            plots[i] = plant;
-            size++;
+        std::lock_guard<std::mutex> lock(stripeFor(i));
+        if(plotAt(i) == nullptr){
+            place(i, plant);
             return true;
         }
     }
@@ -50,9 +65,9 @@ bool Greenhouse::addPlant(Plant *plant)
 
 // bool Greenhouse::removePlant(int position)
 // {
-//     if(position >= 0 && position < capacity && plots[position] != nullptr){
-//         delete plots[position];
-//         plots[position] = nullptr;
+//     if(position >= 0 && position < capacity && plotAt(position) != nullptr){
+//         delete plotAt(position);
+//         plotAt(position) = nullptr;
 //         size--;
 //         notify();
 //         return true;
@@ -62,9 +77,9 @@ bool Greenhouse::addPlant(Plant *plant)
 
 // bool Greenhouse::harvestPlant(int position)
 // {
-//     if(position >= 0 && position < capacity && plots[position] != nullptr && inventory != nullptr){
-//         Plant* plant = plots[position];
-//         plots[position] = nullptr;
+//     if(position >= 0 && position < capacity && plotAt(position) != nullptr && inventory != nullptr){
+//         Plant* plant = plotAt(position);
+//         plotAt(position) = nullptr;
 //         size--;
 //         inventory->add(plant);
 //         notify();
@@ -75,70 +90,181 @@ bool Greenhouse::addPlant(Plant *plant)
 
 bool Greenhouse::removePlant(int position)
 {
-    if(position >= 0 && position < capacity && plots[position] != nullptr){
-        
-        delete plots[position];
-        plots[position] = nullptr; 
-        size--;
-        
-       
-        notify();
-        
-        return true;
+    if(!inRange(position)){
+        return false;
     }
-    return false;
+    {
+        std::lock_guard<std::mutex> lock(stripeFor(position));
+        if(plotAt(position) == nullptr){
+            return false;
+        }
+        // Deleting releases the plant's store slot, so do it under the lock
+        delete take(position);
+    }
+    notify();
+    return true;
 }
 
 bool Greenhouse::harvestPlant(int position)
 {
-    if(position >= 0 && position < capacity && plots[position] != nullptr && inventory != nullptr){
-        
-        Plant* plant = plots[position];
-        plots[position] = nullptr; 
-        size--;
-        
-        inventory->add(plant); 
-        
-        notify();
-        
-        return true;
+    if(!inRange(position) || inventory == nullptr){
+        return false;
     }
-    return false;
+    Plant* plant = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(stripeFor(position));
+        if(plotAt(position) != nullptr){
+            plant = take(position);
+            plant->unbindFromStore();
+        }
+    }
+    return finishHarvest(plant);
 }
+
 bool Greenhouse::harvestPlant(Plant *plant)
 {
-    for(int i = 0; i < capacity; i++){
-        if(plots[i] == plant && inventory != nullptr){
-            plots[i] = nullptr;
-            size--;
-            inventory->add(plant);
-            notify();
-            
-            return true;
+    return harvestPlant(getHandle(plant));
+}
+
+bool Greenhouse::harvestPlant(PlotHandle handle)
+{
+    if(!inRange(handle.index) || inventory == nullptr){
+        return false;
+    }
+    Plant* plant = nullptr;
+    {
+        // Checked and taken under one lock, so two workers racing for the
+        // same ripe plant can't both harvest it
+        std::lock_guard<std::mutex> lock(stripeFor(handle.index));
+        if(plantAt(handle) != nullptr){
+            plant = take(handle.index);
+            plant->unbindFromStore();
         }
     }
-    return false;
+    return finishHarvest(plant);
+}
+
+bool Greenhouse::finishHarvest(Plant* plant)
+{
+    if(plant == nullptr){
+        return false;
+    }
+    // The inventory has its own lock, so harvests land there from any thread
+    inventory->add(plant);
+    notify();
+    return true;
 }
 
 Plant* Greenhouse::getPlant(int position)
 {
-    return plots[position];
+    if(!inRange(position)){
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(stripeFor(position));
+    return plotAt(position);
 }
 
 Plant *Greenhouse::getPlantByPointer(Plant *p)
 {
-    for (auto* plotPlant : plots) {
-            if (plotPlant == p) {
-                return p;
-            }
-        }
-    return nullptr;
+    return findPlant(p) >= 0 ? p : nullptr;
+}
+
+int Greenhouse::findPlant(Plant* plant)
+{
+    // A planted plant knows its slot, so this is a bounds check, not a scan
+    if(plant == nullptr){
+        return -1;
+    }
+    int slot = plant->getPlotIndex();
+    if(!inRange(slot)){
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(stripeFor(slot));
+    return plotAt(slot) == plant ? slot : -1;
+}
+
+PlotHandle Greenhouse::getHandle(int position)
+{
+    PlotHandle handle;
+    if(inRange(position)){
+        std::lock_guard<std::mutex> lock(stripeFor(position));
+        handle.index = position;
+        handle.generation = generationAt(position);
+    }
+    return handle;
+}
+
+PlotHandle Greenhouse::getHandle(Plant* plant)
+{
+    return getHandle(findPlant(plant));
+}
+
+bool Greenhouse::isCurrent(PlotHandle handle)
+{
+    if(!inRange(handle.index)){
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(stripeFor(handle.index));
+    return generationAt(handle.index) == handle.generation;
+}
+
+Plant* Greenhouse::resolve(PlotHandle handle)
+{
+    if(!inRange(handle.index)){
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(stripeFor(handle.index));
+    return plantAt(handle);
+}
+
+PlotSnapshot Greenhouse::inspect(PlotHandle handle)
+{
+    PlotSnapshot snapshot;
+    withPlant(handle, [&](Plant* plant) {
+        snapshot.type = plant->getTypeId();
+        snapshot.stage = plant->getStage();
+        snapshot.growth = plant->getGrowth();
+        snapshot.water = plant->getWater();
+        snapshot.nutrients = plant->getNutrients();
+    });
+    return snapshot;
+}
+
+Plant* Greenhouse::plantAt(PlotHandle handle) const
+{
+    if(generationAt(handle.index) != handle.generation){
+        return nullptr;
+    }
+    return plotAt(handle.index);
+}
+
+void Greenhouse::place(int position, Plant* plant)
+{
+    plotAt(position) = plant;
+    generationAt(position)++;
+    store.bind(position, plant);
+    store.markDirty(position);
+    size++;
+}
+
+Plant* Greenhouse::take(int position)
+{
+    Plant* plant = plotAt(position);
+    plotAt(position) = nullptr;
+    generationAt(position)++;
+    store.markDirty(position);
+    size--;
+    return plant;
 }
 
 std::string Greenhouse::getPlot(int position)
 {
-    if(position >= 0 && position < capacity && plots[position] != nullptr){
-        return plots[position]->getType();
+    if(!inRange(position)){
+        return "Empty";
+    }
+    std::lock_guard<std::mutex> lock(stripeFor(position));
+    if(plotAt(position) != nullptr){
+        return plotAt(position)->getType();
     }
     return "Empty";
 }
@@ -155,12 +281,28 @@ int Greenhouse::getCapacity()
 
 bool Greenhouse::increaseCapacity(int amount)
 {
-    if(amount > 0 && capacity + amount <= 128){
-        capacity += amount;
-        plots.resize(capacity, nullptr);
-        return true;
+    if(amount <= 0){
+        return false;
     }
-    return false;
+    std::lock_guard<std::mutex> lock(growMutex);
+    int current = capacity;
+    if(current + amount > MAX_CAPACITY){
+        return false;
+    }
+    growTo(current + amount);
+    return true;
+}
+
+void Greenhouse::growTo(int newCapacity)
+{
+    for(int c = 0; c * PLOTS_PER_CHUNK < newCapacity; c++){
+        if(chunks[c].load(std::memory_order_relaxed) == nullptr){
+            chunks[c].store(new PlotChunk(), std::memory_order_release);
+        }
+    }
+    store.resize(newCapacity);
+    // Only now can anyone reach the new plots
+    capacity = newCapacity;
 }
 
 void Greenhouse::setInventory(Inventory *inv)
@@ -172,13 +314,23 @@ void Greenhouse::setInventory(Inventory *inv)
 void Greenhouse::attach(Observer* observer)
 {
     if(observer){
-        observers.push_back(observer);
+        {
+            std::lock_guard<std::mutex> lock(observerMutex);
+            for(auto existing : observers){
+                if(existing == observer){
+                    return;
+                }
+            }
+            observers.push_back(observer);
+        }
         observer->setSubject(this);
+        resync(observer);
     }
 }
 
 void Greenhouse::detach(Observer* observer)
 {
+    std::lock_guard<std::mutex> lock(observerMutex);
     for(auto it = observers.begin(); it != observers.end(); ++it){
         if(*it == observer){
             observers.erase(it);
@@ -189,6 +341,7 @@ void Greenhouse::detach(Observer* observer)
 
 void Greenhouse::notify()
 {
+    std::lock_guard<std::mutex> lock(observerMutex);
     for(auto observer : observers){
         observer->update();
     }
@@ -196,18 +349,126 @@ void Greenhouse::notify()
 
 void Greenhouse::tickPlant(int position)
 {
-    if(position >= 0 && position < capacity && plots[position] != nullptr){
-        plots[position]->tick();
-        notify();
+    if(!inRange(position)){
+        return;
     }
+    events.clear();
+    {
+        std::lock_guard<std::mutex> lock(stripeFor(position));
+        if(plotAt(position) == nullptr){
+            return;
+        }
+        plotAt(position)->tick();
+        collectEvents(position, position + 1);
+    }
+    publishEvents();
 }
 
 void Greenhouse::tickAllPlants()
 {
-    for(int i = 0; i < capacity; i++){
-        if(plots[i] != nullptr){
-            plots[i]->tick();
+    tickUntilEvent(1);
+}
+
+int Greenhouse::tickUntilEvent(int maxTicks)
+{
+    if(maxTicks <= 0){
+        return 0;
+    }
+    // The store only hands back plots with something due (a stage change,
+    // death or a threshold); everything else just ages on the clock
+    // without being touched
+    events.clear();
+    const uint32_t start = store.getNow();
+    store.advance(woken, (uint32_t)maxTicks);
+    for(int position : woken){
+        std::lock_guard<std::mutex> lock(stripeFor(position));
+        store.wake(position);
+        collectEvents(position, position + 1);
+    }
+    publishEvents();
+    return (int)(store.getNow() - start);
+}
+
+void Greenhouse::fastForward(long long ticks)
+{
+    while(ticks > 0){
+        ticks -= tickUntilEvent((int)std::min<long long>(ticks, INT_MAX));
+    }
+}
+
+std::vector<int> Greenhouse::takeDirtyPlots()
+{
+    std::vector<int> dirtyPlots;
+    const int count = capacity;
+    for(int begin = 0; begin < count; begin += PLOTS_PER_STRIPE){
+        const int end = std::min(begin + PLOTS_PER_STRIPE, count);
+        std::lock_guard<std::mutex> lock(stripeFor(begin));
+        for(int i = begin; i < end; i++){
+            if(store.takeDirty(i)){
+                dirtyPlots.push_back(i);
+            }
         }
     }
-    notify();
+    return dirtyPlots;
+}
+
+void Greenhouse::collectEvents(int begin, int end)
+{
+    for(int i = begin; i < end; i++){
+        uint8_t crossed = store.takeCrossings(i);
+        if(crossed == 0 || plotAt(i) == nullptr){
+            continue;
+        }
+        PlotHandle plot = {i, generationAt(i)};
+        if(crossed & PlantStore::CROSSED_WATER){
+            events.push_back({PlotEventType::NeedsWater, plot});
+        }
+        if(crossed & PlantStore::CROSSED_NUTRIENTS){
+            events.push_back({PlotEventType::NeedsNutrients, plot});
+        }
+        if(crossed & PlantStore::BECAME_RIPE){
+            events.push_back({PlotEventType::Ripe, plot});
+        }
+    }
+}
+
+void Greenhouse::publishEvents()
+{
+    if(events.empty()){
+        return;
+    }
+    std::lock_guard<std::mutex> lock(observerMutex);
+    for(auto observer : observers){
+        observer->onPlotEvents(events);
+    }
+}
+
+void Greenhouse::resync(Observer* observer)
+{
+    if(!observer){
+        return;
+    }
+
+    std::vector<PlotEvent> current;
+    const int count = capacity;
+    for(int i = 0; i < count; i++){
+        std::lock_guard<std::mutex> lock(stripeFor(i));
+        Plant* plant = plotAt(i);
+        if(plant == nullptr || plant->isDead()){
+            continue;
+        }
+        PlotHandle plot = {i, generationAt(i)};
+        if(plant->getWater() <= PlantStore::NEEDS_WATER_AT){
+            current.push_back({PlotEventType::NeedsWater, plot});
+        }
+        if(plant->getNutrients() <= PlantStore::NEEDS_NUTRIENTS_AT){
+            current.push_back({PlotEventType::NeedsNutrients, plot});
+        }
+        if(plant->isRipe()){
+            current.push_back({PlotEventType::Ripe, plot});
+        }
+    }
+    if(!current.empty()){
+        observer->onPlotEvents(current);
+    }
 }
\ No newline at end of file
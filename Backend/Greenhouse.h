@@ -1,44 +1,158 @@
 #pragma once
 #include <vector>
+#include <atomic>
+#include <mutex>
 #include "Plant.h"
+#include "PlantStore.h"
 #include "Inventory.h"
 #include "Subject.h"
 #include "Observer.h"
+#include "PlotHandle.h"
 
+// A copy of what grows in one plot, taken with the plot locked. Code outside
+// the simulation (the UI, tools) reads plots through these instead of
+// holding on to a Plant* a worker could harvest and delete.
+struct PlotSnapshot
+{
+    PlantTypeId type = PlantTypes::NONE;
+    PlantStage stage = PlantStage::Seed;
+    float growth = 0.0f;
+    float water = 0.0f;
+    float nutrients = 0.0f;
+
+    bool isEmpty() const { return type == PlantTypes::NONE; }
+    bool isRipe() const { return stage == PlantStage::Ripe; }
+    bool isDead() const { return stage == PlantStage::Dead; }
+    const std::string& getType() const { return PlantTypes::name(type); }
+    const char* getStateName() const { return PlantState::stageName(stage); }
+};
+
+// Thread safety: plots are guarded by striped locks, one mutex per block of
+// PLOTS_PER_STRIPE neighbouring plots. Workers touching different blocks
+// never wait on each other, and the tick only locks the plots that have
+// an event due, one at a time. Plots live in chunks of PLOTS_PER_CHUNK
+// that are made as the capacity grows and never move, so
+// increaseCapacity() doesn't disturb anyone using the existing plots.
+// Anything that reads or changes a planted Plant while workers run should
+// go through withPlant() or inspect() rather than a bare Plant*.
 class Greenhouse : public Subject {
 public:
     Greenhouse(Inventory* inv);
     Greenhouse();
     ~Greenhouse();
-    
+
     bool addPlant(Plant* plant, int position);
     bool addPlant(Plant* plant);
     bool removePlant(int position);
     bool harvestPlant(int position);
     bool harvestPlant(Plant* plant);
-    
+    bool harvestPlant(PlotHandle handle);
+
+    // Bare pointers are only safe to use while no worker can harvest or
+    // clear the plot (tests, loading, after WorkerPool::waitIdle()): the
+    // lock is let go on return. Elsewhere use inspect() or withPlant().
     Plant* getPlant(int position);
     Plant* getPlantByPointer(Plant* p) ;
+
+    // Handles are the way to remember a plot across ticks (commands, UI
+    // selection). resolve() is O(1) and returns nullptr once the plot has
+    // been harvested, cleared or replanted since the handle was taken; the
+    // pointer it returns has the same limits as getPlant().
+    PlotHandle getHandle(int position);
+    PlotHandle getHandle(Plant* plant);
+    Plant* resolve(PlotHandle handle);
+    bool isCurrent(PlotHandle handle);
+    int findPlant(Plant* plant);   // plot index of a planted plant, or -1
+
+    // Runs fn(plant) with the plot locked, if the handle still resolves.
+    // Keep fn short and don't call back into this Greenhouse from it.
+    template <typename Fn>
+    bool withPlant(PlotHandle handle, Fn fn)
+    {
+        if(!inRange(handle.index)){
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(stripeFor(handle.index));
+        Plant* plant = plantAt(handle);
+        if(plant == nullptr){
+            return false;
+        }
+        fn(plant);
+        return true;
+    }
+
+    // The plot's plant copied under its lock; empty if the handle is stale
+    PlotSnapshot inspect(PlotHandle handle);
+
     std::string getPlot(int position);
     int getSize();
     int getCapacity();
     bool increaseCapacity(int amount);
     void setInventory(Inventory* inv);
-    
+
     // Subject pattern implementation
     void notify() override;
     void attach(Observer* observer) override;
     void detach(Observer* observer) override;
-    
-    // Called when a plant ticks
+
+    // Called when a plant ticks; observers get the plots that crossed a
+    // threshold as PlotEvents instead of a full notify().
+    // Ticks come from a single driver thread (the SimulationEngine).
     void tickPlant(int position);
     void tickAllPlants();
-    
+    // Runs up to maxTicks ticks, stopping after the first one that had any
+    // events (so observers can react before time moves on), and returns how
+    // many ran. Quiet ticks in between cost nothing.
+    int tickUntilEvent(int maxTicks);
+    // Same as `ticks` calls to tickAllPlants()
+    void fastForward(long long ticks);
+
+    // Sends one observer an event for every plot that currently needs work
+    // (used on attach so a new worker starts from the current state)
+    void resync(Observer* observer);
+
+    // Plots whose occupant or data changed since the last call, in order
+    // (planted, harvested, cleared, ticked or tended). Clears the marks.
+    std::vector<int> takeDirtyPlots();
+
+    static const int PLOTS_PER_CHUNK = PlantStore::CHUNK_SIZE;
+    static const int MAX_CAPACITY = PlantStore::MAX_SLOTS;
+    static const int PLOTS_PER_STRIPE = 8;
+
 private:
-    int size;
-    std::vector<Plant*> plots;
-    int capacity;
+    struct PlotChunk
+    {
+        Plant* plots[PLOTS_PER_CHUNK] = {};
+        uint32_t generations[PLOTS_PER_CHUNK] = {};   // bumped whenever a plot's occupant changes
+        std::mutex stripes[PLOTS_PER_CHUNK / PLOTS_PER_STRIPE];
+    };
+
+    std::atomic<int> size;
+    std::atomic<PlotChunk*> chunks[PlantStore::MAX_CHUNKS];
+    std::atomic<int> capacity;
+    std::mutex growMutex;        // one increaseCapacity() at a time
     Inventory* inventory;
+    PlantStore store;   // SoA simulation data for every plot, indexed like plots
+    std::vector<PlotEvent> events;   // reused between ticks
+    std::vector<int> woken;          // plots with an event this tick, reused too
+
+    std::mutex observerMutex;    // guards observers while notifying
+
+    // position must be in range
+    PlotChunk& chunkFor(int position) const { return *chunks[position / PLOTS_PER_CHUNK].load(std::memory_order_acquire); }
+    std::mutex& stripeFor(int position) { return chunkFor(position).stripes[position % PLOTS_PER_CHUNK / PLOTS_PER_STRIPE]; }
+    Plant*& plotAt(int position) const { return chunkFor(position).plots[position % PLOTS_PER_CHUNK]; }
+    uint32_t& generationAt(int position) const { return chunkFor(position).generations[position % PLOTS_PER_CHUNK]; }
+    bool inRange(int position) const { return position >= 0 && position < capacity.load(); }
+    // Makes the chunks for plots [0, newCapacity) that don't exist yet
+    void growTo(int newCapacity);
+
+    // Helpers below expect the plot's stripe to be held
+    Plant* plantAt(PlotHandle handle) const;
+    void place(int position, Plant* plant);
+    Plant* take(int position);
+    void collectEvents(int begin, int end);
 
-    
-};
\ No newline at end of file
+    bool finishHarvest(Plant* plant);
+    void publishEvents();
+};
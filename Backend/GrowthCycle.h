@@ -1,34 +1,101 @@
 #pragma once
+#include <cstdint>
 
-// Forward declaration instead of include to avoid circular dependency
-class Plant;
+// Growth cycles are compile-time policies: a type with a constexpr
+// MULTIPLIER on the plant's base growth rate
+struct NormalGrowthCycle
+{
+    static constexpr float MULTIPLIER = 1.0f;
+};
 
-class GrowthCycle {
-public:
-    GrowthCycle();
-    virtual ~GrowthCycle();
-    void grow(Plant* plant, float deltaTime);
-    
-protected:
-    virtual float calculateGrowthRate(Plant* plant) = 0;
-    
-private:
-    virtual void applyGrowth(Plant* plant, float growth) = 0;
+struct BoostedGrowthCycle
+{
+    static constexpr float MULTIPLIER = 2.0f;
 };
 
-class BoostedGrowthCycle : public GrowthCycle {
-protected:
-    float calculateGrowthRate(Plant* plant) override;
-    
-private:
-    void applyGrowth(Plant* plant, float growth) override;
-    static const float BOOST_MULTIPLIER;
+// Modifiers on top of the cycle, each a factor on growth
+enum class Season : uint8_t
+{
+    Spring,
+    Summer,
+    Autumn,
+    Winter
+};
+
+enum class Weather : uint8_t
+{
+    Clear,
+    Cloudy,
+    Rain,
+    Heatwave
+};
+
+enum class FertilizerQuality : uint8_t
+{
+    None,
+    Basic,
+    Premium
 };
 
-class NormalGrowthCycle : public GrowthCycle {
-protected:
-    float calculateGrowthRate(Plant* plant) override;
-    
+// What a plant grows by: a cycle policy plus its modifiers, folded into one
+// multiplier when it is set. A plain value inside the Plant, so nothing is
+// allocated per plant and the tick never dispatches through it: the store
+// only ever sees the resulting growth per tick.
+class GrowthCycle
+{
+public:
+    constexpr GrowthCycle() : GrowthCycle(NormalGrowthCycle{}) {}
+
+    template <typename Policy>
+    constexpr GrowthCycle(Policy)
+        : cycleMultiplier(Policy::MULTIPLIER), season(Season::Spring), weather(Weather::Clear),
+          fertilizer(FertilizerQuality::None), multiplier(Policy::MULTIPLIER)
+    {
+    }
+
+    constexpr GrowthCycle with(Season s) const { GrowthCycle c = *this; c.season = s; return c.fold(); }
+    constexpr GrowthCycle with(Weather w) const { GrowthCycle c = *this; c.weather = w; return c.fold(); }
+    constexpr GrowthCycle with(FertilizerQuality f) const { GrowthCycle c = *this; c.fertilizer = f; return c.fold(); }
+
+    constexpr Season getSeason() const { return season; }
+    constexpr Weather getWeather() const { return weather; }
+    constexpr FertilizerQuality getFertilizer() const { return fertilizer; }
+
+    // Cycle and modifiers together
+    constexpr float getMultiplier() const { return multiplier; }
+
+    // Growth per tick for a base rate: the cycle's rate (base rate times
+    // the multiplier), scaled by the base rate once more
+    constexpr float growthPerTick(float baseRate) const { return baseRate * multiplier * baseRate; }
+
+    static constexpr float factor(Season s)
+    {
+        return s == Season::Summer ? 1.25f : s == Season::Autumn ? 0.75f : s == Season::Winter ? 0.5f : 1.0f;
+    }
+    static constexpr float factor(Weather w)
+    {
+        return w == Weather::Cloudy ? 0.8f : w == Weather::Rain ? 1.1f : w == Weather::Heatwave ? 0.6f : 1.0f;
+    }
+    static constexpr float factor(FertilizerQuality f)
+    {
+        return f == FertilizerQuality::Basic ? 1.2f : f == FertilizerQuality::Premium ? 1.5f : 1.0f;
+    }
+
 private:
-    void applyGrowth(Plant* plant, float growth) override;
-};
\ No newline at end of file
+    float cycleMultiplier;
+    Season season;
+    Weather weather;
+    FertilizerQuality fertilizer;
+    float multiplier;
+
+    constexpr GrowthCycle fold() const
+    {
+        GrowthCycle c = *this;
+        c.multiplier = cycleMultiplier * factor(season) * factor(weather) * factor(fertilizer);
+        return c;
+    }
+};
+
+static_assert(GrowthCycle().getMultiplier() == 1.0f, "the default cycle leaves growth alone");
+static_assert(GrowthCycle(BoostedGrowthCycle{}).with(Season::Winter).getMultiplier() == 1.0f,
+              "modifiers fold into a single multiplier at compile time");
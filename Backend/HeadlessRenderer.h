@@ -0,0 +1,24 @@
+#pragma once
+
+// Stand-in for the parts of raylib that the plant visual strategies touch.
+// Only used when building with -DTEMPLANTER_HEADLESS (simulation servers,
+// balancing runs, regression tests): every draw call compiles to a no-op so the
+// Backend links without a window, a GPU or raylib itself.
+
+struct Vector2 { float x; float y; };
+struct Color { unsigned char r; unsigned char g; unsigned char b; unsigned char a; };
+struct Rectangle { float x; float y; float width; float height; };
+
+#define LIGHTGRAY Color{200, 200, 200, 255}
+#define YELLOW    Color{253, 249, 0, 255}
+#define ORANGE    Color{255, 161, 0, 255}
+#define RED       Color{230, 41, 55, 255}
+#define LIME      Color{0, 158, 47, 255}
+#define DARKGREEN Color{0, 117, 44, 255}
+#define BROWN     Color{127, 106, 79, 255}
+
+inline void DrawCircle(int, int, float, Color) {}
+inline void DrawLineEx(Vector2, Vector2, float, Color) {}
+inline void DrawRectangle(int, int, int, int, Color) {}
+inline void DrawRectangleRounded(Rectangle, float, int, Color) {}
+inline void DrawTriangle(Vector2, Vector2, Vector2, Color) {}
@@ -1,66 +1,92 @@
 #include "Inventory.h"
+#include <algorithm>
 
-bool InventorySlot::add(Plant *plant)
+// What comes out of a stack: a fresh plant of the type, already ripe
+static Plant *makeProduce(PlantTypeId type)
 {
-    if (!plant)
-        return false;
-    if (isFull())
-        return false;
+    Plant *plant = PlantTypes::create(type);
+    if (plant)
+        plant->setState(PlantState(100.0f, plant->getWater(), plant->getNutrients(), PlantStage::Ripe));
+    return plant;
+}
+
+int InventorySlot::add(PlantTypeId type, int amount)
+{
+    if (type == PlantTypes::NONE || amount <= 0)
+        return 0;
 
     // If empty slot, accept any plant type
     if (isEmpty())
     {
-        plantType = plant->getType(); // Assuming Plant has getType() method
-        items.push_back(plant);
-        return true;
+        typeId = type;
     }
-
     // If not empty, check type compatibility
-    if (plant->getType() != plantType)
+    else if (type != typeId)
     {
-        return false;
+        return 0;
     }
 
-    items.push_back(plant);
-    return true;
+    int added = std::min(amount, getRemainingCapacity());
+    count += added;
+    return added;
 }
 
-Plant *InventorySlot::remove()
+bool InventorySlot::add(Plant *plant)
 {
-    if (isEmpty())
-        return nullptr;
+    if (!plant || add(plant->getTypeId(), 1) == 0)
+        return false;
 
-    Plant *plant = items.back();
-    items.pop_back();
+    // Harvested produce is all alike: the count is all we keep
+    delete plant;
+    return true;
+}
+
+int InventorySlot::take(int amount)
+{
+    int taken = std::min(amount, getSize());
+    if (taken <= 0)
+        return 0;
+    count -= taken;
 
     // Clear plant type if slot becomes empty
     if (isEmpty())
     {
-        plantType.clear();
+        typeId = PlantTypes::NONE;
     }
+    return taken;
+}
 
-    return plant;
+Plant *InventorySlot::remove()
+{
+    if (isEmpty())
+        return nullptr;
+
+    PlantTypeId type = typeId;
+    take(1);
+    return makeProduce(type);
 }
 
-bool InventorySlot::canAccept(Plant *plant) const
+bool InventorySlot::canAccept(PlantTypeId type) const
 {
-    if (!plant)
+    if (type == PlantTypes::NONE)
         return false;
     if (isFull())
         return false;
     if (isEmpty())
         return true;
-    return plant->getType() == plantType;
+    return type == typeId;
+}
+
+bool InventorySlot::canAccept(Plant *plant) const
+{
+    return plant && canAccept(plant->getTypeId());
 }
 
 // Inventory Implementation
-Inventory::Inventory(int capacity) : maxSlots(capacity)
+Inventory::Inventory(int capacity) : maxSlots(capacity), occupiedSlots(0), openStacks(0), freeHint(0)
 {
     slots.resize(maxSlots);
-    for (int i = 0; i < maxSlots; i++)
-    {
-        slots[i] = nullptr;
-    }
+    dirty.resize(maxSlots, 0);
 }
 
 Inventory::~Inventory()
@@ -73,183 +99,384 @@ bool Inventory::add(Plant *plant)
     if (!plant) {
         return false;
     }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (addItems(plant->getTypeId(), 1) == 0) {
+        return false;
+    }
 
+    // Only the count is kept
+    delete plant;
+    return true;
+}
 
-    // Try to find existing compatible slot
-    InventorySlot *slot = findCompatibleSlot(plant);
+int Inventory::add(PlantTypeId type, int amount)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return addItems(type, amount);
+}
 
-    if (slot)
+int Inventory::addItems(PlantTypeId type, int amount)
+{
+    if (type == PlantTypes::NONE)
+        return 0;
+
+    int added = 0;
+    while (added < amount)
     {
-        return slot->add(plant);
-    }
-    
-    // Create new slot (removes the bad check!)
-    slot = createNewSlot();
-    if (!slot) {
-        return false;
-    }
+        // Try to find existing compatible slot
+        int index = findCompatibleSlot(type);
 
-    return slot->add(plant);
+        if (index >= 0 && slots[index].getRemainingCapacity() > amount - added)
+        {
+            // Common case: it all fits, so only the counts move
+            slots[index].add(type, amount - added);
+            countByType[type] += amount - added;
+            markDirty(index);
+            return amount;
+        }
+
+        // Fill up that stack, or start a new one (removes the bad check!)
+        if (index < 0)
+            index = createNewSlot();
+        if (index < 0)
+            break;
+
+        unlinkSlot(index);
+        int n = slots[index].add(type, amount - added);
+        linkSlot(index);
+        markDirty(index);
+        if (n == 0)
+            break;
+        added += n;
+    }
+    return added;
 }
 
 Plant *Inventory::removeItem(const std::string &plantType)
 {
-    for (int i = 0; i < slots.size(); i++) // Use index iteration
-    {
-        InventorySlot *slot = slots[i];
-        if (slot != nullptr && slot->getPlantType() == plantType)
-        {
-            Plant *plant = slot->remove();
+    PlantTypeId type = PlantTypes::find(plantType);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (type >= stacksByType.size() || stacksByType[type].empty())
+        return nullptr;
 
-            if (slot->isEmpty())
-            {
-                delete slot;
-                slots[i] = nullptr; 
-            }
+    // Lowest slot of that type first, like the old front-to-back scan
+    int i = stacksByType[type].front();
 
-            return plant;
-        }
-    }
-    return nullptr;
+    unlinkSlot(i);
+    slots[i].take(1);
+    linkSlot(i);
+    markDirty(i);
+
+    // Someone needs an actual plant (to sell, to show): make one now
+    return makeProduce(type);
 }
 
 bool Inventory::removeStack(size_t index)
 {
+    std::lock_guard<std::mutex> lock(mutex);
     if (index >= slots.size())
         return false;
 
-    InventorySlot *slot = slots[index];
-
-    while (!slot->isEmpty())
-    {
-        Plant *plant = slot->remove();
-        delete plant;
-    }
-
+    // Everything after it shifts down one, and the old last index empties
+    for (size_t i = index; i < slots.size(); i++)
+        markDirty(i);
     slots.erase(slots.begin() + index);
-    delete slot;
 
+    rebuildIndex();
     return true;
 }
 
 int Inventory::getPlantCount(const std::string &plantType) const
 {
-    int count = 0;
-    for (const auto *slot : slots)
-    {
-        if (slot != nullptr && slot->getPlantType() == plantType) 
-        {
-            count += slot->getSize();
-        }
-    }
-    return count;
+    PlantTypeId type = PlantTypes::find(plantType);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (type >= countByType.size())
+        return 0;
+    return countByType[type];
+}
+
+size_t Inventory::getStackCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return slots.size();
 }
 
 bool Inventory::isFull() const
 {
- int filledSlots = 0;
-    for (const auto *slot : slots)
-    {
-        if (slot != nullptr)  
-        {
-            filledSlots++;
-            if (!slot->isFull())
-                return false;
-        }
-    }
-    return filledSlots >= maxSlots;
+    std::lock_guard<std::mutex> lock(mutex);
+    return occupiedSlots >= (int)maxSlots && openStacks == 0;
 }
 
-const InventorySlot *Inventory::getSlot(size_t index) const
+InventorySlot Inventory::getSlot(size_t index) const
 {
+    std::lock_guard<std::mutex> lock(mutex);
     if (index >= slots.size())
-        return nullptr;
+        return InventorySlot();
     return slots[index];
 }
 
+std::vector<InventorySlot> Inventory::getSlots() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return slots;
+}
+
+size_t Inventory::getMaxSlots() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxSlots;
+}
+
+void Inventory::setMaxSlots(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    maxSlots = capacity;
+}
+
 void Inventory::clear()
 {
-    for (int i = 0; i < slots.size(); i++)
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < slots.size(); i++)
     {
-        InventorySlot *inventorySlot = slots[i];
-        if (inventorySlot  != nullptr)  
+        if (!slots[i].isEmpty())
         {
-            while (!inventorySlot->isEmpty())
-            {
-                Plant *plant = inventorySlot->remove();
-                delete plant;
-            }
-            delete inventorySlot;
+            slots[i] = InventorySlot();
+            markDirty(i);
         }
-        slots[i] = nullptr;
     }
+    rebuildIndex();
 }
 
-InventorySlot *Inventory::findCompatibleSlot(Plant *plant)
+int Inventory::findCompatibleSlot(PlantTypeId type)
 {
-    for (auto *slot : slots)
+    if (type >= openByType.size() || openByType[type].empty())
     {
-        // Skip nullptr slots!
-        if (slot != nullptr && slot->canAccept(plant))
-        {
-            return slot;
-        }
+        return -1;
     }
-    return nullptr;
+    return openByType[type].front();
 }
 
-InventorySlot *Inventory::createNewSlot()
+int Inventory::createNewSlot()
 {
-    // Find first nullptr slot
-    for (int i = 0; i < slots.size(); i++)
+    // Find first empty slot; it counts as occupied once linked with a stack
+    for (size_t i = freeHint; i < slots.size(); i++)
     {
-        if (slots[i] == nullptr)
+        if (slots[i].isEmpty())
         {
-            slots[i] = new InventorySlot();
-            return slots[i];
+            freeHint = i + 1;
+            return (int)i;
         }
     }
+    freeHint = slots.size();
+
+    return -1; // No empty slots
+}
 
-    return nullptr; // No empty slots
+void Inventory::unlinkSlot(size_t slotIndex)
+{
+    const InventorySlot &slot = slots[slotIndex];
+    if (slot.isEmpty())
+        return;
+
+    occupiedSlots--;
+    PlantTypeId type = slot.getPlantTypeId();
+
+    std::vector<int> &stacks = stacksByType[type];
+    stacks.erase(std::lower_bound(stacks.begin(), stacks.end(), (int)slotIndex));
+    if (!slot.isFull())
+    {
+        std::vector<int> &open = openByType[type];
+        open.erase(std::lower_bound(open.begin(), open.end(), (int)slotIndex));
+        openStacks--;
+    }
+    countByType[type] -= slot.getSize();
+}
+
+void Inventory::linkSlot(size_t slotIndex)
+{
+    const InventorySlot &slot = slots[slotIndex];
+    if (slot.isEmpty())
+    {
+        freeHint = std::min(freeHint, slotIndex);
+        return;
+    }
+
+    occupiedSlots++;
+    PlantTypeId type = slot.getPlantTypeId();
+
+    if (type >= stacksByType.size())
+    {
+        stacksByType.resize(type + 1);
+        openByType.resize(type + 1);
+        countByType.resize(type + 1, 0);
+    }
+
+    std::vector<int> &stacks = stacksByType[type];
+    stacks.insert(std::lower_bound(stacks.begin(), stacks.end(), (int)slotIndex), (int)slotIndex);
+    if (!slot.isFull())
+    {
+        std::vector<int> &open = openByType[type];
+        open.insert(std::lower_bound(open.begin(), open.end(), (int)slotIndex), (int)slotIndex);
+        openStacks++;
+    }
+    countByType[type] += slot.getSize();
+}
+
+void Inventory::rebuildIndex()
+{
+    stacksByType.clear();
+    openByType.clear();
+    countByType.clear();
+    occupiedSlots = 0;
+    openStacks = 0;
+    freeHint = slots.size();
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        linkSlot(i);
+    }
+}
+void Inventory::markDirty(size_t slotIndex)
+{
+    if (slotIndex >= dirty.size())
+        dirty.resize(slotIndex + 1, 0);
+    if (!dirty[slotIndex])
+    {
+        dirty[slotIndex] = 1;
+        dirtySlots.push_back((int)slotIndex);
+    }
+}
+
+std::vector<int> Inventory::takeDirtySlots()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<int> taken;
+    taken.swap(dirtySlots);
+    for (int index : taken)
+        dirty[index] = 0;
+    std::sort(taken.begin(), taken.end());
+    return taken;
+}
+
+std::vector<std::pair<int, InventorySlot>> Inventory::takeDirtyStacks()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::pair<int, InventorySlot>> taken;
+    std::sort(dirtySlots.begin(), dirtySlots.end());
+    taken.reserve(dirtySlots.size());
+    for (int index : dirtySlots)
+    {
+        dirty[index] = 0;
+        // Indices past the end are slots removeStack() shifted away: empty now
+        taken.emplace_back(index, (size_t)index < slots.size() ? slots[index] : InventorySlot());
+    }
+    dirtySlots.clear();
+    return taken;
+}
+
+void Inventory::clearSlot(size_t slotIndex)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (slotIndex >= slots.size() || slots[slotIndex].isEmpty())
+        return;
+
+    unlinkSlot(slotIndex);
+    slots[slotIndex] = InventorySlot();
+    linkSlot(slotIndex);
+    markDirty(slotIndex);
 }
 
 void Inventory::swapSlots(int index1, int index2)
 {
-    if (index1 < 0 || index1 >= maxSlots || index2 < 0 || index2 >= maxSlots)
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index1 < 0 || index1 >= (int)maxSlots || index2 < 0 || index2 >= (int)maxSlots)
     {
         return;
     }
+    if (index1 == index2)
+        return;
 
-    InventorySlot *temp = slots[index1];
-    slots[index1] = slots[index2];
-    slots[index2] = temp;
+    unlinkSlot(index1);
+    unlinkSlot(index2);
+    std::swap(slots[index1], slots[index2]);
+    linkSlot(index1);
+    linkSlot(index2);
+    markDirty(index1);
+    markDirty(index2);
 }
 
 void Inventory::swapBetweenInventories(Inventory* inv1, int index1, Inventory* inv2, int index2)
 {
     if (!inv1 || !inv2) return;
-    if (index1 < 0 || index1 >= inv1->maxSlots) return;
-    if (index2 < 0 || index2 >= inv2->maxSlots) return;
+    if (inv1 == inv2)
+    {
+        inv1->swapSlots(index1, index2);
+        return;
+    }
 
-    // Simple pointer swap
-    InventorySlot* temp = inv1->slots[index1];
-    inv1->slots[index1] = inv2->slots[index2];
-    inv2->slots[index2] = temp;
+    // Both locks at once, in whatever order avoids a deadlock with a swap
+    // going the other way
+    std::scoped_lock lock(inv1->mutex, inv2->mutex);
+    if (index1 < 0 || index1 >= (int)inv1->maxSlots) return;
+    if (index2 < 0 || index2 >= (int)inv2->maxSlots) return;
+
+    // Swap the stacks, with each side's index following its slot
+    inv1->unlinkSlot(index1);
+    inv2->unlinkSlot(index2);
+    std::swap(inv1->slots[index1], inv2->slots[index2]);
+    inv1->linkSlot(index1);
+    inv2->linkSlot(index2);
+    inv1->markDirty(index1);
+    inv2->markDirty(index2);
 }
 
 bool Inventory::addToSpecificSlot(Plant* plant, size_t slotIndex)
 {
     if (!plant) return false;
-    if (slotIndex >= slots.size()) return false;
-    
-    InventorySlot* slot = slots[slotIndex];
-    
-    // If slot doesn't exist, create it
-    if (slot == nullptr) {
-        slot = new InventorySlot();
-        slots[slotIndex] = slot;
-    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (addToSlot(plant->getTypeId(), 1, slotIndex) == 0) return false;
+
+    delete plant;
+    return true;
+}
+
+int Inventory::addToSpecificSlot(PlantTypeId type, int amount, size_t slotIndex)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return addToSlot(type, amount, slotIndex);
+}
+
+int Inventory::addToSlot(PlantTypeId type, int amount, size_t slotIndex)
+{
+    if (slotIndex >= slots.size()) return 0;
     
-    // Try to add to this specific slot
-    return slot->add(plant);
-}
\ No newline at end of file
+    unlinkSlot(slotIndex);
+    // Try to add to this specific slot (an empty one takes any type)
+    int added = slots[slotIndex].add(type, amount);
+    linkSlot(slotIndex);
+    markDirty(slotIndex);
+    return added;
+}
+
+int Inventory::mergeSlots(int fromIndex, int toIndex)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fromIndex < 0 || fromIndex >= (int)slots.size() || toIndex < 0 || toIndex >= (int)slots.size())
+        return 0;
+    if (fromIndex == toIndex || slots[fromIndex].isEmpty() || slots[toIndex].isEmpty())
+        return 0;
+
+    InventorySlot &from = slots[fromIndex];
+    InventorySlot &to = slots[toIndex];
+    if (!to.canAccept(from.getPlantTypeId()))
+        return 0;
+
+    unlinkSlot(fromIndex);
+    unlinkSlot(toIndex);
+    int moved = to.add(from.getPlantTypeId(), from.getSize());
+    from.take(moved);
+    linkSlot(fromIndex);
+    linkSlot(toIndex);
+    markDirty(fromIndex);
+    markDirty(toIndex);
+    return moved;
+}
@@ -1,57 +1,79 @@
 #pragma once
+#include <cstdint>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include "Plant.h"
 
+// One stack of harvested produce. Harvested plants of a type are
+// interchangeable, so a stack is just a type and a count; a Plant object
+// is only made again when one is taken out.
 class InventorySlot
 {
 public:
     InventorySlot() = default;
 
+    // Adds up to amount items of the type; returns how many fit
+    int add(PlantTypeId type, int amount = 1);
+    // Takes the plant's type and deletes the plant; false (plant kept by the
+    // caller) if it doesn't fit
     bool add(Plant *plant);
 
+    // Removes up to amount items; returns how many were removed
+    int take(int amount = 1);
+    // Removes one item as a fresh ripe plant (caller deletes it)
     Plant *remove();
 
+    bool canAccept(PlantTypeId type) const;
     bool canAccept(Plant *plant) const;
 
-    bool isFull() const { return items.size() >= capacity; }
+    bool isFull() const { return count >= capacity; }
 
-    bool isEmpty() const { return items.empty(); }
+    bool isEmpty() const { return count == 0; }
 
-    int getSize() const { return items.size(); }
+    int getSize() const { return count; }
 
-    std::string getPlantType() const { return plantType; }
+    const std::string& getPlantType() const { return PlantTypes::name(typeId); }
+    PlantTypeId getPlantTypeId() const { return typeId; }
 
-    int getRemainingCapacity() const { return capacity - items.size(); }
+    int getRemainingCapacity() const { return capacity - count; }
 
-    Plant* getPlant(int index) const 
-    {
-        if (index >= 0 && index < (int)items.size()) { return items[index]; }
-        return nullptr;
-    }
-    
-private:
     static constexpr int capacity = 64;
-    std::string plantType;
-    std::vector<Plant *> items;
+
+private:
+    PlantTypeId typeId = PlantTypes::NONE;
+    uint16_t count = 0;
 };
 
+// Thread safety: every public method takes the inventory's own lock, so
+// workers harvesting on pool threads and the main thread selling, drawing
+// or saving can all use it at once. That is also why getSlot() hands out a
+// copy rather than a pointer into the inventory.
 class Inventory
 {
 public:
     Inventory(int capacity);
     ~Inventory();
 
+    // Stores the plant as one more item of its type and deletes it. On
+    // false the inventory is full and the caller still owns the plant.
     bool add(Plant *plant);
+    // Adds amount items of the type, stacking like add(); returns how many fit
+    int add(PlantTypeId type, int amount);
+    // Takes one item of the type out as a fresh ripe plant (caller deletes it)
     Plant *removeItem(const std::string &plantType);
     bool removeStack(size_t index);
     int getPlantCount(const std::string &plantType) const;
-    size_t getStackCount() const { return slots.size(); }
-    bool isFull() const;
-    const InventorySlot *getSlot(size_t index) const;
+    size_t getStackCount() const;
+    bool isFull() const;   // no empty slot and every stack at capacity
+    // The stack at index as it is now; an empty slot if there is none
+    InventorySlot getSlot(size_t index) const;
+    // Every slot, empty ones included, read under one lock (for saves)
+    std::vector<InventorySlot> getSlots() const;
     void clear();
 
-    size_t getMaxSlots() const { return maxSlots; }
-    void setMaxSlots(size_t capacity) { maxSlots = capacity; }
+    size_t getMaxSlots() const;
+    void setMaxSlots(size_t capacity);
 
     // Frontend methods
     void swapSlots(int index1, int index2);
@@ -59,10 +81,44 @@ public:
     // NEW: Cross-inventory swap
     static void swapBetweenInventories(Inventory* inv1, int index1, Inventory* inv2, int index2);
     bool addToSpecificSlot(Plant* plant, size_t slotIndex);
+    int addToSpecificSlot(PlantTypeId type, int amount, size_t slotIndex);
+    // Moves as many items as fit from one stack onto another of the same type
+    int mergeSlots(int fromIndex, int toIndex);
+    // Empties one slot in place (later slots keep their index)
+    void clearSlot(size_t slotIndex);
+
+    // Slot indices changed since the last call, ascending; clears the marks.
+    // Used by delta saves to write only the stacks that moved.
+    std::vector<int> takeDirtySlots();
+    // takeDirtySlots() together with the stacks now in those slots, under
+    // one lock: a harvest landing meanwhile is either in what comes back or
+    // marked again for the next delta, never neither.
+    std::vector<std::pair<int, InventorySlot>> takeDirtyStacks();
 
 private:
+    mutable std::mutex mutex;   // guards everything below
     size_t maxSlots;
-    std::vector<InventorySlot *> slots;
-    InventorySlot *findCompatibleSlot(Plant *plant);
-    InventorySlot *createNewSlot();
+    std::vector<InventorySlot> slots;   // an empty slot holds no stack
+    std::vector<uint8_t> dirty;      // per slot index
+    std::vector<int> dirtySlots;     // indices with dirty set, unsorted
+    // Bodies of the public adds, for callers already holding the lock
+    int addItems(PlantTypeId type, int amount);
+    int addToSlot(PlantTypeId type, int amount, size_t slotIndex);
+    int findCompatibleSlot(PlantTypeId type);
+    int createNewSlot();
+    void markDirty(size_t slotIndex);
+
+    // Type index, kept up to date by every change so add, removeItem and
+    // getPlantCount don't scan the slots. Lists hold slot indices, ascending.
+    std::vector<std::vector<int>> stacksByType;   // every stack of the type
+    std::vector<std::vector<int>> openByType;     // stacks with room left
+    std::vector<int> countByType;
+    int occupiedSlots;
+    int openStacks;
+    size_t freeHint;   // no empty slot below this index
+
+    // Take a slot out of the index before changing it, put it back after
+    void unlinkSlot(size_t slotIndex);
+    void linkSlot(size_t slotIndex);
+    void rebuildIndex();
 };
\ No newline at end of file
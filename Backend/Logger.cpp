@@ -0,0 +1,256 @@
+#include "Logger.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstdlib>
+
+std::atomic<Logger*> Logger::instance{nullptr};
+std::mutex Logger::instanceMutex;
+std::atomic<unsigned int> Logger::generation{0};
+
+namespace
+{
+long long nowMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}
+
+// Per-thread handle on the ring this thread produces into.
+// Released when the thread exits so a later thread can reuse the ring.
+struct LoggerThreadSlot
+{
+    Logger::Ring* ring = nullptr;
+    unsigned int owner = 0;
+
+    ~LoggerThreadSlot()
+    {
+        if (ring)
+            ring->inUse.store(false, std::memory_order_release);
+    }
+};
+
+static thread_local LoggerThreadSlot threadSlot;
+
+Logger::Logger()
+    : id(++generation),
+      level((int)LogLevel::Info),
+      dropped(0),
+      nextThreadId(0),
+      output(stderr),
+      startMicros(nowMicros()),
+      running(true)
+{
+    drainThread = std::thread(&Logger::drainLoop, this);
+}
+
+Logger::~Logger()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wake.notify_all();
+    if (drainThread.joinable())
+        drainThread.join();
+
+    drainAll();
+
+    if (output && output != stderr)
+        fclose(output);
+
+    // Rings of threads that are still alive stay allocated: their slots may
+    // still touch them on exit. They are never drained again.
+    for (Ring* ring : rings)
+    {
+        if (!ring->inUse.load(std::memory_order_acquire))
+            delete ring;
+    }
+}
+
+Logger* Logger::getInstance()
+{
+    Logger* logger = instance.load(std::memory_order_acquire);
+    if (logger)
+        return logger;
+
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    logger = instance.load(std::memory_order_relaxed);
+    if (!logger)
+    {
+        static bool registered = false;
+        if (!registered)
+        {
+            std::atexit(Logger::shutdown);
+            registered = true;
+        }
+        logger = new Logger();
+        instance.store(logger, std::memory_order_release);
+    }
+    return logger;
+}
+
+void Logger::shutdown()
+{
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    Logger* logger = instance.exchange(nullptr);
+    delete logger;
+}
+
+bool Logger::isEnabled(LogLevel level) const
+{
+    return (int)level >= this->level.load(std::memory_order_relaxed);
+}
+
+void Logger::setLevel(LogLevel level)
+{
+    this->level.store((int)level, std::memory_order_relaxed);
+}
+
+LogLevel Logger::getLevel() const
+{
+    return (LogLevel)level.load(std::memory_order_relaxed);
+}
+
+bool Logger::setOutputFile(const std::string& path)
+{
+    FILE* file = path.empty() ? nullptr : fopen(path.c_str(), "a");
+
+    // Anything already buffered belongs to the old destination
+    drainAll();
+
+    std::lock_guard<std::mutex> lock(drainMutex);
+    if (output && output != stderr)
+        fclose(output);
+    output = file ? file : stderr;
+    return file != nullptr;
+}
+
+Logger::Ring* Logger::acquireRing()
+{
+    std::lock_guard<std::mutex> lock(ringsMutex);
+
+    Ring* ring = nullptr;
+    for (Ring* candidate : rings)
+    {
+        bool expected = false;
+        if (candidate->inUse.compare_exchange_strong(expected, true))
+        {
+            ring = candidate;
+            break;
+        }
+    }
+    if (!ring)
+    {
+        ring = new Ring();
+        ring->inUse.store(true);
+        rings.push_back(ring);
+    }
+    ring->threadId = ++nextThreadId;
+    return ring;
+}
+
+void Logger::log(LogLevel level, const char* format, ...)
+{
+    if (!isEnabled(level))
+        return;
+
+    if (threadSlot.owner != id || !threadSlot.ring)
+    {
+        threadSlot.ring = acquireRing();
+        threadSlot.owner = id;
+    }
+    Ring* ring = threadSlot.ring;
+
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->head.load(std::memory_order_acquire) >= (size_t)RING_CAPACITY)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Record& record = ring->records[tail & (RING_CAPACITY - 1)];
+    record.timeMicros = nowMicros() - startMicros;
+    record.level = level;
+    record.threadId = ring->threadId;
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(record.text, MESSAGE_SIZE, format, args);
+    va_end(args);
+
+    ring->tail.store(tail + 1, std::memory_order_release);
+}
+
+void Logger::flush()
+{
+    drainAll();
+}
+
+unsigned long long Logger::getDroppedCount() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+const char* Logger::levelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Trace:
+        return "TRACE";
+    case LogLevel::Debug:
+        return "DEBUG";
+    case LogLevel::Info:
+        return "INFO";
+    case LogLevel::Warn:
+        return "WARN";
+    case LogLevel::Error:
+        return "ERROR";
+    default:
+        return "OFF";
+    }
+}
+
+void Logger::drainLoop()
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (running)
+    {
+        wake.wait_for(lock, std::chrono::milliseconds(20));
+        lock.unlock();
+        drainAll();
+        lock.lock();
+    }
+}
+
+// Records from different threads come out grouped by ring, not strictly
+// interleaved by time; every line carries its timestamp and thread id.
+void Logger::drainAll()
+{
+    std::vector<Ring*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        snapshot = rings;
+    }
+
+    std::lock_guard<std::mutex> lock(drainMutex);
+    bool wrote = false;
+    for (Ring* ring : snapshot)
+    {
+        size_t head = ring->head.load(std::memory_order_relaxed);
+        size_t tail = ring->tail.load(std::memory_order_acquire);
+        for (; head != tail; head++)
+        {
+            const Record& record = ring->records[head & (RING_CAPACITY - 1)];
+            fprintf(output, "[%10.3f] %-5s t%-2u %s\n",
+                    record.timeMicros / 1000000.0, levelName(record.level),
+                    record.threadId, record.text);
+            wrote = true;
+        }
+        ring->head.store(head, std::memory_order_release);
+    }
+
+    if (wrote)
+        fflush(output);
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compile-time floor: calls below this level are compiled out.
+// 0 = trace, 1 = debug, 2 = info, 3 = warn, 4 = error, 5 = off.
+// Build with e.g. -DTEMPLANTER_LOG_LEVEL=1 to get the per-tick debug chatter.
+#ifndef TEMPLANTER_LOG_LEVEL
+#define TEMPLANTER_LOG_LEVEL 2
+#endif
+
+enum class LogLevel : uint8_t
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+// Asynchronous logger.
+// Each thread writes fixed-size records into its own lock-free ring buffer
+// (single producer, single consumer), so logging from the tick loop or a worker
+// thread is one vsnprintf and never touches the console. A background thread
+// drains every ring and writes the records in batches to stderr or a file.
+// If a ring is full the record is dropped and counted rather than blocking.
+class Logger
+{
+public:
+    static Logger* getInstance();
+    // Drains everything still buffered, stops the drain thread and frees the logger
+    static void shutdown();
+
+    bool isEnabled(LogLevel level) const;
+    void setLevel(LogLevel level);
+    LogLevel getLevel() const;
+
+    // Empty path (or a path that can't be opened) switches back to stderr
+    bool setOutputFile(const std::string& path);
+
+    void log(LogLevel level, const char* format, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 3, 4)))
+#endif
+        ;
+
+    // Blocks until every record logged before the call has been written out
+    void flush();
+
+    unsigned long long getDroppedCount() const;
+
+    static const char* levelName(LogLevel level);
+
+    static const int MESSAGE_SIZE = 192;
+    static const int RING_CAPACITY = 256; // records per thread, power of two
+
+    struct Record
+    {
+        long long timeMicros;
+        LogLevel level;
+        unsigned int threadId;
+        char text[MESSAGE_SIZE];
+    };
+
+    struct Ring
+    {
+        Record records[RING_CAPACITY];
+        alignas(64) std::atomic<size_t> head{0}; // next record to drain (consumer)
+        alignas(64) std::atomic<size_t> tail{0}; // next free record (producer)
+        std::atomic<bool> inUse{false};
+        unsigned int threadId = 0;
+    };
+
+private:
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    Ring* acquireRing();
+    void drainLoop();
+    void drainAll();
+
+    static std::atomic<Logger*> instance;
+    static std::mutex instanceMutex;
+    static std::atomic<unsigned int> generation; // bumped per logger so stale thread slots re-register
+
+    unsigned int id;
+    std::atomic<int> level;
+    std::atomic<unsigned long long> dropped;
+
+    std::mutex ringsMutex;     // guards the rings list (registration only)
+    std::vector<Ring*> rings;
+    unsigned int nextThreadId;
+
+    std::mutex drainMutex;     // one consumer at a time; guards output
+    FILE* output;
+    long long startMicros;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool running;
+    std::thread drainThread;
+
+    friend struct LoggerThreadSlot;
+};
+
+#define TEMPLANTER_LOG_AT(lvl, ...)                             \
+    do                                                          \
+    {                                                           \
+        Logger* templanterLogger = Logger::getInstance();       \
+        if (templanterLogger->isEnabled(lvl))                   \
+            templanterLogger->log(lvl, __VA_ARGS__);            \
+    } while (0)
+
+// The level test is a constant, so disabled calls are dropped by the compiler
+// (arguments are still type-checked, never evaluated)
+#define TEMPLANTER_LOG_IF(min, lvl, ...)                 \
+    do                                                   \
+    {                                                    \
+        if (TEMPLANTER_LOG_LEVEL <= (min))               \
+            TEMPLANTER_LOG_AT(lvl, __VA_ARGS__);         \
+    } while (0)
+
+#define LOG_TRACE(...) TEMPLANTER_LOG_IF(0, LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) TEMPLANTER_LOG_IF(1, LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) TEMPLANTER_LOG_IF(2, LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...) TEMPLANTER_LOG_IF(3, LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) TEMPLANTER_LOG_IF(4, LogLevel::Error, __VA_ARGS__)
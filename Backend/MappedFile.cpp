@@ -0,0 +1,98 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : bytes(nullptr), length(0), fileHandle(nullptr), mappingHandle(nullptr)
+{
+}
+#else
+MappedFile::MappedFile() : bytes(nullptr), length(0)
+{
+}
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    // FILE_SHARE_DELETE so a new save can still be renamed over this one
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = (const char*)view;
+    length = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping holds its own reference
+    if (view == MAP_FAILED)
+        return false;
+
+    bytes = (const char*)view;
+    length = (size_t)info.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (!bytes)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(bytes);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    munmap((void*)bytes, length);
+#endif
+    bytes = nullptr;
+    length = 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are only read from disk
+// when something touches them, so opening a large save costs the same as
+// opening a small one. Saves are always replaced by rename (see Caretaker),
+// never rewritten in place, so a mapping keeps seeing the file it opened.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // False for missing or empty files
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return bytes != nullptr; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const char* bytes;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
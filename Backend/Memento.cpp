@@ -1,7 +1,8 @@
 #include "Memento.h"
+#include "MappedFile.h"
 
 Memento::Memento(const std::string& inv, const std::string& work, 
-                 const std::string& gh, float m, int r, int d, int h, int min)
+                 const std::string& gh, float m, int r, int d, int h, int min, int format, bool delta)
     : inventoryData(inv), 
       workerData(work), 
       greenhouseData(gh), 
@@ -9,24 +10,86 @@ Memento::Memento(const std::string& inv, const std::string& work,
       rating(r), 
       day(d), 
       hour(h), 
-      minute(min)
+      minute(min),
+      format(format),
+      delta(delta),
+      expectedChecksum(0),
+      verified(1)
+{}
+
+Memento::Memento(std::shared_ptr<const MappedFile> source, BinaryReader inv, BinaryReader work, BinaryReader gh,
+                 float m, int r, int d, int h, int min, int format, bool delta)
+    : money(m),
+      rating(r),
+      day(d),
+      hour(h),
+      minute(min),
+      format(format),
+      delta(delta),
+      source(std::move(source)),
+      inventoryView(inv),
+      workerView(work),
+      greenhouseView(gh),
+      expectedChecksum(0),
+      verified(1)
 {}
 
 Memento::~Memento() {}
 
+// A mapped memento copies a payload out of the file the first time it is
+// asked for as a string
+static const std::string& materialize(std::string& owned, const std::shared_ptr<const MappedFile>& source,
+                                      const BinaryReader& view)
+{
+    if (source && owned.empty() && view.remaining() > 0)
+        owned.assign(view.position(), view.remaining());
+    return owned;
+}
+
 const std::string& Memento::getInventoryData() const 
 {
-    return inventoryData;
+    return materialize(inventoryData, source, inventoryView);
 }
 
 const std::string& Memento::getWorkerData() const 
 {
-    return workerData;
+    return materialize(workerData, source, workerView);
 }
 
 const std::string& Memento::getGreenhouseData() const 
 {
-    return greenhouseData;
+    return materialize(greenhouseData, source, greenhouseView);
+}
+
+BinaryReader Memento::readInventory() const
+{
+    return source ? inventoryView : BinaryReader(inventoryData);
+}
+
+BinaryReader Memento::readWorkers() const
+{
+    return source ? workerView : BinaryReader(workerData);
+}
+
+BinaryReader Memento::readGreenhouse() const
+{
+    return source ? greenhouseView : BinaryReader(greenhouseData);
+}
+
+void Memento::deferChecksum(BinaryReader bytes, uint32_t expected)
+{
+    checkedBytes = bytes;
+    expectedChecksum = expected;
+    verified = -1;
+}
+
+bool Memento::verify() const
+{
+    if (verified < 0)
+    {
+        verified = SaveFormat::crc32(checkedBytes.position(), checkedBytes.remaining()) == expectedChecksum ? 1 : 0;
+    }
+    return verified == 1;
 }
 
 float Memento::getMoney() const 
@@ -52,4 +115,14 @@ int Memento::getHour() const
 int Memento::getMinute() const 
 {
     return minute;
-}
\ No newline at end of file
+}
+
+int Memento::getFormat() const
+{
+    return format;
+}
+
+bool Memento::isDelta() const
+{
+    return delta;
+}
@@ -1,30 +1,67 @@
 #pragma once
+#include <cstdint>
+#include <memory>
 #include <string>
+#include "SaveFormat.h"
+
+class MappedFile;
 
 class Memento 
 {
 public:
-    Memento(const std::string& inv, const std::string& work, const std::string& gh, float m, int r, int d, int h, int min);
+    // Data strings are Serializer payloads in the given format. A delta
+    // memento only carries the plots and inventory slots that changed since
+    // the snapshot before it, and has to be applied on top of that state.
+    Memento(const std::string& inv, const std::string& work, const std::string& gh, float m, int r, int d, int h, int min,
+            int format = SaveFormat::VERSION, bool delta = false);
+    // Binary payloads left in a mapped save file: nothing is copied until
+    // a get*Data() call asks for a string, and the read*() views never copy
+    Memento(std::shared_ptr<const MappedFile> source, BinaryReader inv, BinaryReader work, BinaryReader gh,
+            float m, int r, int d, int h, int min, int format = SaveFormat::VERSION, bool delta = false);
     ~Memento();
     
     const std::string& getInventoryData() const;
     const std::string& getWorkerData() const;
     const std::string& getGreenhouseData() const;
+
+    // Readers over the payload bytes, wherever they live
+    BinaryReader readInventory() const;
+    BinaryReader readWorkers() const;
+    BinaryReader readGreenhouse() const;
+
+    // For a mapped save whose checksum hasn't been checked yet: check it on
+    // first call (touching every page of the file) and remember the result
+    void deferChecksum(BinaryReader checkedBytes, uint32_t expected);
+    bool verify() const;
     
     float getMoney() const;
     int getRating() const;
     int getDay() const;
     int getHour() const;
     int getMinute() const;
+    int getFormat() const;   // save version the payloads are in, or LEGACY_TEXT for old text saves
+    bool isDelta() const;
 
     private:
-    std::string inventoryData;
-    std::string workerData;
-    std::string greenhouseData;
+    // Owned payloads; for a mapped memento these are only filled on demand
+    mutable std::string inventoryData;
+    mutable std::string workerData;
+    mutable std::string greenhouseData;
     
     float money;
     int rating;
     int day;
     int hour;
     int minute;
+    int format;
+    bool delta;
+
+    std::shared_ptr<const MappedFile> source;   // keeps the views below alive
+    BinaryReader inventoryView;
+    BinaryReader workerView;
+    BinaryReader greenhouseView;
+
+    BinaryReader checkedBytes;
+    uint32_t expectedChecksum;
+    mutable int8_t verified;   // -1 not checked yet, 0 bad, 1 good
 };
\ No newline at end of file
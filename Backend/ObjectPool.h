@@ -0,0 +1,226 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Counters for one pool. heapAllocations only moves when the pool has to
+// grow (or an object is too big for its blocks), so a steady state that
+// keeps reusing blocks leaves it flat.
+struct PoolStats
+{
+    uint64_t allocations = 0;       // blocks handed out
+    uint64_t frees = 0;             // blocks given back
+    uint64_t heapAllocations = 0;   // slabs and oversize objects taken from the heap
+
+    uint64_t live() const { return allocations - frees; }
+};
+
+// Fixed-size block allocator for objects the game makes and drops all the
+// time. Meant to back a class's operator new/delete, so the `new X` and
+// `delete x` call sites stay as they are.
+//
+// Each thread keeps its own free list, so an allocate or free is a pointer
+// pop or push with no lock. Threads trade whole batches with a shared depot
+// when their list runs dry or grows long; that matters for commands, which
+// are made on the game thread and freed on pool threads. Blocks come from
+// slabs that are kept for the life of the process.
+//
+// Tag only keeps pools apart (one per class using it). Sizes above BlockSize
+// go straight to the heap, so a bigger subclass still works.
+template <typename Tag, size_t BlockSize>
+class BlockPool
+{
+public:
+    static void* allocate(size_t size)
+    {
+        Depot& shared = depot();
+        shared.allocations.fetch_add(1, std::memory_order_relaxed);
+        if (size > BLOCK)
+        {
+            shared.heapAllocations.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        if (threadExiting())
+            return allocateShared();
+
+        Cache& local = cache();
+        if (local.head == nullptr)
+            refill(local);
+        FreeBlock* block = local.head;
+        local.head = block->next;
+        local.count--;
+        return block;
+    }
+
+    static void deallocate(void* p, size_t size)
+    {
+        if (p == nullptr)
+            return;
+        Depot& shared = depot();
+        shared.frees.fetch_add(1, std::memory_order_relaxed);
+        if (size > BLOCK)
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        if (threadExiting())
+        {
+            std::lock_guard<std::mutex> lock(shared.mtx);
+            block->next = nullptr;
+            shared.batches.push_back({block, 1});
+            return;
+        }
+
+        Cache& local = cache();
+        block->next = local.head;
+        local.head = block;
+        local.count++;
+        if (local.count >= 2 * BATCH)
+            spill(local);
+    }
+
+    static PoolStats stats()
+    {
+        Depot& shared = depot();
+        PoolStats out;
+        out.allocations = shared.allocations.load(std::memory_order_relaxed);
+        out.frees = shared.frees.load(std::memory_order_relaxed);
+        out.heapAllocations = shared.heapAllocations.load(std::memory_order_relaxed);
+        return out;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    static constexpr size_t ALIGN = alignof(std::max_align_t);
+    static constexpr size_t RAW_BLOCK = BlockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : BlockSize;
+    static constexpr size_t BLOCK = (RAW_BLOCK + ALIGN - 1) / ALIGN * ALIGN;
+    static constexpr size_t BATCH = 64;         // blocks moved to or from the depot at once
+    static constexpr size_t SLAB_BLOCKS = 256;
+
+    struct Batch
+    {
+        FreeBlock* head;
+        size_t count;
+    };
+
+    struct Depot
+    {
+        std::mutex mtx;
+        std::vector<Batch> batches;
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> heapAllocations{0};
+    };
+
+    struct Cache
+    {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+
+        // A finished thread hands its blocks back for the others
+        ~Cache()
+        {
+            threadExiting() = true;
+            if (head == nullptr)
+                return;
+            Depot& shared = depot();
+            std::lock_guard<std::mutex> lock(shared.mtx);
+            shared.batches.push_back({head, count});
+        }
+    };
+
+    // Never destroyed: thread caches flush into it at exit, in no set order
+    static Depot& depot()
+    {
+        static Depot* shared = new Depot();
+        return *shared;
+    }
+
+    static Cache& cache()
+    {
+        static thread_local Cache local;
+        return local;
+    }
+
+    // Set once this thread's cache is gone; objects freed later in its exit
+    // (static destructors on the main thread) go through the depot lock
+    static bool& threadExiting()
+    {
+        static thread_local bool exiting = false;
+        return exiting;
+    }
+
+    static FreeBlock* carveSlab()
+    {
+        depot().heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        char* slab = static_cast<char*>(::operator new(BLOCK * SLAB_BLOCKS));
+        FreeBlock* head = nullptr;
+        for (size_t i = 0; i < SLAB_BLOCKS; i++)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * BLOCK);
+            block->next = head;
+            head = block;
+        }
+        return head;
+    }
+
+    static void* allocateShared()
+    {
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mtx);
+        if (shared.batches.empty())
+            shared.batches.push_back({carveSlab(), SLAB_BLOCKS});
+        Batch& batch = shared.batches.back();
+        FreeBlock* block = batch.head;
+        batch.head = block->next;
+        if (--batch.count == 0)
+            shared.batches.pop_back();
+        return block;
+    }
+
+    static void refill(Cache& local)
+    {
+        Depot& shared = depot();
+        {
+            std::lock_guard<std::mutex> lock(shared.mtx);
+            if (!shared.batches.empty())
+            {
+                Batch batch = shared.batches.back();
+                shared.batches.pop_back();
+                local.head = batch.head;
+                local.count = batch.count;
+                return;
+            }
+        }
+
+        // Nothing to reuse: carve a new slab
+        local.head = carveSlab();
+        local.count = SLAB_BLOCKS;
+    }
+
+    // Moves BATCH blocks from a long thread list to the depot
+    static void spill(Cache& local)
+    {
+        Batch batch = {local.head, BATCH};
+        FreeBlock* last = local.head;
+        for (size_t i = 1; i < BATCH; i++)
+            last = last->next;
+        local.head = last->next;
+        local.count -= BATCH;
+        last->next = nullptr;
+
+        Depot& shared = depot();
+        std::lock_guard<std::mutex> lock(shared.mtx);
+        shared.batches.push_back(batch);
+    }
+};
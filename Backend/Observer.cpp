@@ -9,4 +9,10 @@ Observer::Observer() {
 
 bool Observer::operator==(Observer* observer) {
     return this->id == observer->id;
+}
+
+void Observer::onPlotEvents(const std::vector<PlotEvent>& events) {
+    if (!events.empty()) {
+        update();
+    }
 }
\ No newline at end of file
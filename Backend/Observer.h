@@ -1,4 +1,6 @@
 #pragma once
+#include <vector>
+#include "PlotEvent.h"
 
 // Forward declarations
 class Greenhouse;
@@ -10,6 +12,9 @@ public:
     
     virtual void update() = 0;
     virtual void setSubject(Greenhouse* greenhouse) = 0;
+    // Plots that changed since the last tick; observers that only know how
+    // to rescan everything fall back to update()
+    virtual void onPlotEvents(const std::vector<PlotEvent>& events);
     
     bool operator==(Observer* observer);
     
@@ -1,63 +1,88 @@
 #include "Plant.h"
 #include <string>
-#include <iostream>
-#include "GrowthCycle.h"
-#include "PlantState.h"    // Defines PlantState and SeedState
+#include "Logger.h"
+#include "PlantState.h"
+#include "PlantStore.h"
 
 #include "../Frontend/PlantVisualStrategy.h" 
 
-Plant::Plant(std::string type, float growthRate, float sellPrice, PlantVisualStrategy* strategy) 
-    : state(nullptr), 
-      type(type), 
+Plant::Plant(std::string type, float growthRate, float sellPrice, const PlantVisualStrategy* strategy) 
+    : state(0.0f, 100.0f, 100.0f, PlantStage::Seed), 
+      growthCycle(),
+      typeId(PlantTypes::intern(type)),
       growthRate(growthRate),
       sellPrice(sellPrice),
-      growthCycle(new NormalGrowthCycle()),
-      visualStrategy(strategy)
+      visualStrategy(strategy),
+      store(nullptr),
+      storeSlot(-1)
 {
-    // Fix: State construction requires the full definition of SeedState
-    state = new SeedState(0.0f, 100.0f, 100.0f);
+}
+
+static const PlantDescriptor& DescriptorFor(PlantTypeId type)
+{
+    static const PlantDescriptor unknown = {"", 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, PlantTypes::NONE};
+    const PlantDescriptor* descriptor = PlantTypes::describe(type);
+    return descriptor ? *descriptor : unknown;
+}
+
+Plant::Plant(PlantTypeId type, const PlantVisualStrategy* strategy)
+    : state(0.0f, 100.0f, 100.0f, PlantStage::Seed),
+      growthCycle(),
+      typeId(type),
+      growthRate(DescriptorFor(type).growthRate),
+      sellPrice(DescriptorFor(type).sellPrice),
+      visualStrategy(strategy),
+      store(nullptr),
+      storeSlot(-1)
+{
+}
+
+typedef BlockPool<Plant, sizeof(Plant)> PlantPool;
+
+void* Plant::operator new(size_t size)
+{
+    return PlantPool::allocate(size);
+}
+
+void Plant::operator delete(void* p, size_t size)
+{
+    PlantPool::deallocate(p, size);
+}
+
+PoolStats Plant::poolStats()
+{
+    return PlantPool::stats();
 }
 
 Plant::~Plant()
 {
-    if(state){
-        delete state;
-    }
-    if(growthCycle){
-        delete growthCycle;
-    }
-    if(visualStrategy){
-        delete visualStrategy;
+    if(store){
+        store->release(storeSlot);
     }
 }
 
 void Plant::draw(float x, float y, float initialWidth, float initialHeight) const {
     if (visualStrategy) {
-        float progress = state ? (state->getGrowth() / 100.0f) : 0.0f;
+        float progress = getGrowth() / 100.0f;
         
         float currentWidth = initialWidth * (0.3f + 0.7f * progress);
         float currentHeight = initialHeight * (0.3f + 0.7f * progress);
         
-        visualStrategy->setDimensions(currentWidth, currentHeight);
-        visualStrategy->setGrowth(progress);
-        
-        visualStrategy->setDead(isDead()); 
-
-        visualStrategy->drawDetailed(x, y);
+        visualStrategy->drawDetailed(x, y, currentWidth, currentHeight, fmaxf(0.0f, fminf(1.0f, progress)), isDead());
     }
 }
 
-void Plant::setGrowthCycle(GrowthCycle *gc)
+void Plant::setGrowthCycle(const GrowthCycle& gc)
 {
-    delete growthCycle;
-    this->growthCycle = gc;
+    growthCycle = gc;
+    if(store){
+        store->setGrowthPerTick(storeSlot, getGrowthPerTick());
+    }
 }
 
-void Plant::applyGrowthToState(float growth)
+const GrowthCycle& Plant::getGrowthCycle() const
 {
-    if(state) {
-        state->applyGrowth(growth * growthRate);
-    }
+    return growthCycle;
 }
 
 float Plant::getBaseGrowthRate() const
@@ -65,6 +90,11 @@ float Plant::getBaseGrowthRate() const
     return growthRate;
 }
 
+float Plant::getGrowthPerTick() const
+{
+    return growthCycle.growthPerTick(growthRate);
+}
+
 float Plant::getSellPrice() const
 {
     return sellPrice;
@@ -72,103 +102,165 @@ float Plant::getSellPrice() const
 
 void Plant::tick() 
 {
+    if (store) {
+        store->tick(storeSlot);
+        return;
+    }
 
     if (isDead()) {
         return; 
     }
 
-    if (state) {
-        state->tick(this);
-        if (growthCycle && !isDead()) {
-            growthCycle->grow(this, 1.0f);
-        }
+    state.tick();
+    if (!state.isDead()) {
+        state.applyGrowth(getGrowthPerTick());
+    }
+}
+
+void Plant::fastForward(uint32_t ticks)
+{
+    if (store) {
+        store->fastForward(storeSlot, ticks);
+        return;
     }
+    state.fastForward(ticks, getGrowthPerTick());
 }
+
 float Plant::getGrowthRate() const 
 {
     return growthRate;
 }
 
 
-void Plant::setState(PlantState* newState) 
+void Plant::setState(const PlantState& newState) 
 {
-    if (state != newState) {
-        if (state) {
-            delete state;
-        }
-        state = newState;
+    state = newState;
+    if (store) {
+        store->load(storeSlot, state);
     }
 }
 
-std::string Plant::getType()
+const std::string& Plant::getType() const
+{
+    return PlantTypes::name(typeId);
+}
+
+PlantTypeId Plant::getTypeId() const
+{
+    return typeId;
+}
+
+const PlantDescriptor* Plant::getDescriptor() const
 {
-    return type;
+    return PlantTypes::describe(typeId);
 }
 
 std::string Plant::getState()
 {
-    return state->getState();
+    if (store) return PlantState::stageName((PlantStage)store->getStateId(storeSlot));
+    return state.getState();
 }
 
 // FIX: This function requires the full definition of PlantState
 PlantState *Plant::getPlantState()
 {
-    return this->state;
+    syncFromStore();
+    return &state;
 }
 
 std::string Plant::getStateName() const 
 {
-    return state ? state->getState() : "Unknown";
+    if (store) return PlantState::stageName((PlantStage)store->getStateId(storeSlot));
+    return state.getStateName();
+}
+
+PlantStage Plant::getStage() const
+{
+    if (store) return (PlantStage)store->getStateId(storeSlot);
+    return state.getStage();
 }
 
 float Plant::getWater() const 
 {
-    return state ? state->getWater() : 0.0f;
+    if (store) return store->getWater(storeSlot);
+    return state.getWater();
 }
 
 float Plant::getNutrients() const 
 {
-    return state ? state->getNutrients() : 0.0f;
+    if (store) return store->getNutrients(storeSlot);
+    return state.getNutrients();
 }
 
 float Plant::getGrowth() const 
 {
-    return state ? state->getGrowth() : 0.0f;
+    if (store) return store->getGrowth(storeSlot);
+    return state.getGrowth();
 }
 
 bool Plant::isRipe() const 
 {
-    return state && state->getState() == "Ripe";
+    if (store) return store->getStateId(storeSlot) == (uint8_t)PlantStage::Ripe;
+    return state.isRipe();
 }
 
 bool Plant::isDead() const 
 {
-    return state && state->getState() == "Dead";
+    if (store) return store->getStateId(storeSlot) == (uint8_t)PlantStage::Dead;
+    return state.isDead();
 }
 
 void Plant::fertilize(float amount)
 {
-    if(state) state->addNutrients(amount);
+    if(store) store->addNutrients(storeSlot, amount);
+    else state.addNutrients(amount);
 }
 
 void Plant::water(float amount)
 {
-    if(state) state->addWater(amount);
+    if(store) store->addWater(storeSlot, amount);
+    else state.addWater(amount);
 }
 
 void Plant::printStatus() const {
-    std::cout << "========================================" << std::endl;
-    std::cout << "Plant: " << type << std::endl;
-    std::cout << "State: " << getStateName() << std::endl;
-    std::cout << "Growth: " << std::fixed << getGrowth() << "%" << std::endl;
-    std::cout << "Water: " << getWater() << "%" << std::endl;
-    std::cout << "Nutrients: " << getNutrients() << "%" << std::endl;
-    std::cout << "Growth Rate: " << growthRate << "x" << std::endl;
-    
-    if (isRipe()) {
-        std::cout << "✓ Ready to harvest!" << std::endl;
-    } else if (isDead()) {
-        std::cout << "✗ Plant is dead" << std::endl;
-    }
-    std::cout << "========================================" << std::endl;
+    const char* verdict = isRipe() ? " - ready to harvest" : (isDead() ? " - plant is dead" : "");
+    LOG_INFO("Plant %s: %s, growth %.1f%%, water %.1f%%, nutrients %.1f%%, rate %.2fx%s",
+             getType().c_str(), getStateName().c_str(), getGrowth(), getWater(), getNutrients(),
+             growthRate, verdict);
+}
+
+void Plant::bindToStore(PlantStore* plantStore, int slot)
+{
+    store = plantStore;
+    storeSlot = slot;
+}
+
+void Plant::unbindFromStore()
+{
+    if (!store) return;
+
+    syncFromStore();
+    store->release(storeSlot);
+    store = nullptr;
+    storeSlot = -1;
+}
+
+bool Plant::isBound() const
+{
+    return store != nullptr;
+}
+
+int Plant::getPlotIndex() const
+{
+    return storeSlot;
+}
+
+void Plant::syncFromStore()
+{
+    if (!store) return;
+
+    state = PlantState(store->getGrowth(storeSlot),
+                       store->getWater(storeSlot),
+                       store->getNutrients(storeSlot),
+                       (PlantStage)store->getStateId(storeSlot));
 }
\ No newline at end of file
@@ -3,38 +3,56 @@
 #pragma once
 
 #include "PlantState.h"       
+#include "PlantTypes.h"
+#include "ObjectPool.h"
+#include "GrowthCycle.h"
 #include "../Frontend/PlantVisualStrategy.h"      
 #include <string>
 
 // Forward declarations
-class GrowthCycle;
+class PlantStore;
 
 
 class Plant
 {
 public:
     // MODIFIED BASE CONSTRUCTOR
-    Plant(std::string type, float growthRate, float sellPrice, PlantVisualStrategy* strategy);
+    Plant(std::string type, float growthRate, float sellPrice, const PlantVisualStrategy* strategy);
+    // A crop from the PlantTypes registry, with its rate and price
+    Plant(PlantTypeId type, const PlantVisualStrategy* strategy);
     Plant(const Plant &other);
     virtual ~Plant();
+
+    // Planting, harvesting and reloads make and drop plants constantly;
+    // they come from a BlockPool (the subclasses add no members)
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+    static PoolStats poolStats();
     
     // GrowthCycle integration
-    void setGrowthCycle(GrowthCycle* gc);
-    void applyGrowthToState(float growth);
+    void setGrowthCycle(const GrowthCycle& gc);
+    const GrowthCycle& getGrowthCycle() const;
     float getBaseGrowthRate() const;
+    float getGrowthPerTick() const;
     
     // State management
     void tick();
-    void setState(PlantState* newState);
+    // `ticks` calls to tick(). A planted plant jumps there in closed form
+    // (its store ticks the same way); a loose one replays the ticks.
+    void fastForward(uint32_t ticks);
+    void setState(const PlantState& newState);
     
     // NEW: Draw method
     void draw(float x, float y, float initialWidth, float initialHeight) const;
     
     // Getters
-    std::string getType();
+    const std::string& getType() const;
+    PlantTypeId getTypeId() const;   // interned getType(), for fast comparisons
+    const PlantDescriptor* getDescriptor() const;   // nullptr if not a registered crop
     std::string getState();
-    PlantState* getPlantState(); // Requires PlantState.h
+    PlantState* getPlantState();
     std::string getStateName() const;
+    PlantStage getStage() const;
     float getGrowthRate() const;
     float getWater() const;
     float getNutrients() const;
@@ -49,66 +67,81 @@ public:
     
     void printStatus() const;
 
+    // Greenhouse binding: while bound, the simulation data lives in the
+    // PlantStore slot and this object is only a handle onto it
+    void bindToStore(PlantStore* store, int slot);
+    void unbindFromStore();
+    bool isBound() const;
+    int getPlotIndex() const;   // store slot == greenhouse plot, -1 when unbound
+
 protected:
-    PlantState* state;
-    GrowthCycle* growthCycle;
-    std::string type;
+    PlantState state;
+    GrowthCycle growthCycle;
+    PlantTypeId typeId;
     float growthRate;
     float sellPrice;
     
-    PlantVisualStrategy* visualStrategy; 
+    // Shared flyweight from PlantVisualFactory: not owned
+    const PlantVisualStrategy* visualStrategy;
+
+    PlantStore* store;
+    int storeSlot;
+
+    // Copies the store slot back into the PlantState object
+    void syncFromStore();
 };
 
 
-// --- Derived Plant Classes (MODIFIED to accept and pass the strategy) ---
+// --- Derived Plant Classes: named shorthands for the built-in crops, whose
+// rates and prices live in PlantTypes::BUILT_IN ---
 
 class Lettuce : public Plant {
 public:
     // Accepts strategy from the Factory
-    Lettuce(PlantVisualStrategy* strategy) : Plant("Lettuce", 1.6f, 15.0f, strategy) {} 
+    Lettuce(const PlantVisualStrategy* strategy) : Plant(PlantTypes::LETTUCE, strategy) {}
 };
 
 class Carrot : public Plant {
 public:
-    Carrot(PlantVisualStrategy* strategy) : Plant("Carrot", 1.4f, 25.0f, strategy) {}
+    Carrot(const PlantVisualStrategy* strategy) : Plant(PlantTypes::CARROT, strategy) {}
 };
 
 class Potato : public Plant {
 public:
-    Potato(PlantVisualStrategy* strategy) : Plant("Potato", 1.2f, 35.0f, strategy) {}
+    Potato(const PlantVisualStrategy* strategy) : Plant(PlantTypes::POTATO, strategy) {}
 };
 
 class Cucumber : public Plant {
 public:
-    Cucumber(PlantVisualStrategy* strategy) : Plant("Cucumber", 1.1f, 45.0f, strategy) {}
+    Cucumber(const PlantVisualStrategy* strategy) : Plant(PlantTypes::CUCUMBER, strategy) {}
 };
 
 class Tomato : public Plant {
 public:
-    Tomato(PlantVisualStrategy* strategy) : Plant("Tomato", 1.0f, 55.0f, strategy) {}
+    Tomato(const PlantVisualStrategy* strategy) : Plant(PlantTypes::TOMATO, strategy) {}
 };
 
 class Pepper : public Plant {
 public:
-    Pepper(PlantVisualStrategy* strategy) : Plant("Pepper", 0.9f, 65.0f, strategy) {}
+    Pepper(const PlantVisualStrategy* strategy) : Plant(PlantTypes::PEPPER, strategy) {}
 };
 
 class Sunflower : public Plant {
 public:
-    Sunflower(PlantVisualStrategy* strategy) : Plant("Sunflower", 0.8f, 80.0f, strategy) {}
+    Sunflower(const PlantVisualStrategy* strategy) : Plant(PlantTypes::SUNFLOWER, strategy) {}
 };
 
 class Strawberry : public Plant {
 public:
-    Strawberry(PlantVisualStrategy* strategy) : Plant("Strawberry", 0.7f, 100.0f, strategy) {}
+    Strawberry(const PlantVisualStrategy* strategy) : Plant(PlantTypes::STRAWBERRY, strategy) {}
 };
 
 class Corn : public Plant {
 public:
-    Corn(PlantVisualStrategy* strategy) : Plant("Corn", 0.6f, 120.0f, strategy) {}
+    Corn(const PlantVisualStrategy* strategy) : Plant(PlantTypes::CORN, strategy) {}
 };
 
 class Pumpkin : public Plant {
 public:
-    Pumpkin(PlantVisualStrategy* strategy) : Plant("Pumpkin", 0.5f, 200.0f, strategy) {}
+    Pumpkin(const PlantVisualStrategy* strategy) : Plant(PlantTypes::PUMPKIN, strategy) {}
 };
\ No newline at end of file
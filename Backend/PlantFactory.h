@@ -12,96 +12,79 @@ public:
     virtual Plant *produce() = 0;
 };
 
-class CarrotFactory : public PlantFactory
+// Makes plants of one registered crop (see PlantTypes)
+class CropFactory : public PlantFactory
 {
 public:
+    explicit CropFactory(PlantTypeId type) : type(type) {}
     Plant *produce() override
     {
-        return new Carrot(new CarrotVisualStrategy(15.0f, 30.0f));
+        return PlantTypes::create(type);
     }
+    PlantTypeId getType() const { return type; }
+
+private:
+    PlantTypeId type;
 };
 
-class TomatoFactory : public PlantFactory
+class CarrotFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Tomato(new TomatoVisualStrategy(25.0f, 25.0f));
-    }
+    CarrotFactory() : CropFactory(PlantTypes::CARROT) {}
 };
 
-class LettuceFactory : public PlantFactory
+class TomatoFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Lettuce(new LettuceVisualStrategy(20.0f, 15.0f));
-    }
+    TomatoFactory() : CropFactory(PlantTypes::TOMATO) {}
 };
 
-// --- You will need to complete the rest of these factories ---
+class LettuceFactory : public CropFactory
+{
+public:
+    LettuceFactory() : CropFactory(PlantTypes::LETTUCE) {}
+};
 
-class SunflowerFactory : public PlantFactory
+class SunflowerFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Sunflower(new SunflowerVisualStrategy(25.0f, 50.0f));
-    }
+    SunflowerFactory() : CropFactory(PlantTypes::SUNFLOWER) {}
 };
 
-class PotatoFactory : public PlantFactory
+class PotatoFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Potato(new PotatoVisualStrategy(18.0f, 20.0f));
-    }
+    PotatoFactory() : CropFactory(PlantTypes::POTATO) {}
 };
 
-class CucumberFactory : public PlantFactory
+class CucumberFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Cucumber(new CucumberVisualStrategy(20.0f, 35.0f));
-    }
+    CucumberFactory() : CropFactory(PlantTypes::CUCUMBER) {}
 };
 
-class PepperFactory : public PlantFactory
+class PepperFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Pepper(new PepperVisualStrategy(25.0f, 30.0f));
-    }
+    PepperFactory() : CropFactory(PlantTypes::PEPPER) {}
 };
 
-class StrawberryFactory : public PlantFactory
+class StrawberryFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Strawberry(new StrawberryVisualStrategy(25.0f, 15.0f));
-    }
+    StrawberryFactory() : CropFactory(PlantTypes::STRAWBERRY) {}
 };
 
-class CornFactory : public PlantFactory
+class CornFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Corn(new CornVisualStrategy(20.0f, 55.0f));
-    }
+    CornFactory() : CropFactory(PlantTypes::CORN) {}
 };
 
-class PumpkinFactory : public PlantFactory
+class PumpkinFactory : public CropFactory
 {
 public:
-    Plant *produce() override
-    {
-        return new Pumpkin(new PumpkinVisualStrategy(40.0f, 30.0f));
-    }
+    PumpkinFactory() : CropFactory(PlantTypes::PUMPKIN) {}
 };
 
 class RandomPlantFactory : public PlantFactory
@@ -114,75 +97,75 @@ public:
         // switch (dist(rng()))
         // {
         // case 0:
-        //     return new Carrot(new CarrotVisualStrategy(15.0f, 30.0f));
+        //     return new Carrot(PlantVisualFactory::getInstance().getVisual("Carrot"));
         //     break;
         // case 1:
-        //     return new Tomato(new TomatoVisualStrategy(25.0f, 25.0f));
+        //     return new Tomato(PlantVisualFactory::getInstance().getVisual("Tomato"));
         //     break;
         // case 2:
-        //     return new Sunflower(new SunflowerVisualStrategy(25.0f, 50.0f));
+        //     return new Sunflower(PlantVisualFactory::getInstance().getVisual("Sunflower"));
         //     break;
         // case 3:
-        //     return new Lettuce(new LettuceVisualStrategy(20.0f, 15.0f));
+        //     return new Lettuce(PlantVisualFactory::getInstance().getVisual("Lettuce"));
         //     break;
         // case 4:
-        //     return new Potato(new PotatoVisualStrategy(18.0f, 20.0f));
+        //     return new Potato(PlantVisualFactory::getInstance().getVisual("Potato"));
         //     break;
         // case 5:
-        //     return new Cucumber(new CucumberVisualStrategy(20.0f, 35.0f));
+        //     return new Cucumber(PlantVisualFactory::getInstance().getVisual("Cucumber"));
         //     break;
         // case 6:
-        //     return new Pepper(new PepperVisualStrategy(25.0f, 30.0f));
+        //     return new Pepper(PlantVisualFactory::getInstance().getVisual("Pepper"));
         //     break;
         // case 7:
-        //     return new Strawberry(new StrawberryVisualStrategy(25.0f, 15.0f));
+        //     return new Strawberry(PlantVisualFactory::getInstance().getVisual("Strawberry"));
         //     break;
         // case 8:
-        //     return new Corn(new CornVisualStrategy(20.0f, 55.0f));
+        //     return new Corn(PlantVisualFactory::getInstance().getVisual("Corn"));
         //     break;
         // default:
-        //     return new Pumpkin(new PumpkinVisualStrategy(40.0f, 30.0f));
+        //     return new Pumpkin(PlantVisualFactory::getInstance().getVisual("Pumpkin"));
         //     break;
         // }
         if (dist(rng()) < 30)
         {
-            return new Lettuce(new LettuceVisualStrategy(20.0f, 15.0f));
+            return PlantTypes::create(PlantTypes::LETTUCE);
         }
         else if (dist(rng()) < 60)
         {
-            return new Tomato(new TomatoVisualStrategy(25.0f, 25.0f));
+            return PlantTypes::create(PlantTypes::TOMATO);
         }
         else if (dist(rng()) < 65)
         {
-            return new Carrot(new CarrotVisualStrategy(15.0f, 30.0f));
+            return PlantTypes::create(PlantTypes::CARROT);
         }
         else if (dist(rng()) < 70)
         {
-            return new Sunflower(new SunflowerVisualStrategy(25.0f, 50.0f));
+            return PlantTypes::create(PlantTypes::SUNFLOWER);
         }
         else if (dist(rng()) < 75)
         {
-            return new Potato(new PotatoVisualStrategy(18.0f, 20.0f));
+            return PlantTypes::create(PlantTypes::POTATO);
         }
         else if (dist(rng()) < 80)
         {
-            return new Cucumber(new CucumberVisualStrategy(20.0f, 35.0f));
+            return PlantTypes::create(PlantTypes::CUCUMBER);
         }
         else if (dist(rng()) < 85)
         {
-            return new Pepper(new PepperVisualStrategy(25.0f, 30.0f));
+            return PlantTypes::create(PlantTypes::PEPPER);
         }
         else if (dist(rng()) < 90)
         {
-            return new Strawberry(new StrawberryVisualStrategy(25.0f, 15.0f));
+            return PlantTypes::create(PlantTypes::STRAWBERRY);
         }
         else if (dist(rng()) < 95)
         {
-            return new Corn(new CornVisualStrategy(20.0f, 55.0f));
+            return PlantTypes::create(PlantTypes::CORN);
         }
         else
         {
-            return new Pumpkin(new PumpkinVisualStrategy(40.0f, 30.0f));
+            return PlantTypes::create(PlantTypes::PUMPKIN);
         }
     }
 
@@ -1,40 +1,64 @@
 #include "PlantState.h"
-#include "Plant.h"
 #include <algorithm>
-#include <iostream>
+#include <cmath>
+#include "Logger.h"
 
-const float PlantState::SEED_TO_GROWING_THRESHOLD = 25.0f;
-const float PlantState::GROWING_TO_RIPE_THRESHOLD = 100.0f;
-const float PlantState::DEATH_WATER_THRESHOLD = 0.0f;
-const float PlantState::DEATH_NUTRIENT_THRESHOLD = 0.0f;
-const float PlantState::WATER_CONSUMPTION_RATE = 2.0f;     
-const float PlantState::NUTRIENT_CONSUMPTION_RATE = 1.0f; 
-const float PlantState::GROWTH_PER_TICK = 3.0f;
+PlantState::PlantState() : growth(0.0f), water(100.0f), nutrients(100.0f), stage(PlantStage::Seed) {}
 
-PlantState::PlantState() : growth(0.0f), water(100.0f), nutrients(100.0f) {}
+PlantState::PlantState(float gr, float wa, float nu, PlantStage stage)
+    : growth(gr), water(wa), nutrients(nu), stage(stage) {}
 
-PlantState::PlantState(float gr, float wa, float nu) 
-    : growth(gr), water(wa), nutrients(nu) {}
+void PlantState::tick() {
+    const StageRules& rules = RULES[(int)stage];
 
-PlantState::PlantState(const PlantState& other) 
-    : growth(other.growth), water(other.water), nutrients(other.nutrients) {}
+    if (stage == PlantStage::Dead) {
+        growth = std::max(0.0f, growth - DEAD_DECAY_PER_TICK);
+        return;
+    }
+
+    consumeResources(rules.waterUse, rules.nutrientUse);
+
+    if (rules.lowWarning > 0.0f && (water <= rules.lowWarning || nutrients <= rules.lowWarning)) {
+        LOG_DEBUG("[%s] Low resources! Water: %.1f, Nutrients: %.1f", getStateName(), water, nutrients);
+    }
+
+    PlantStage next = nextStage(stage, growth, water, nutrients);
+    if (next == stage) {
+        return;
+    }
+
+    if (next == PlantStage::Dead) {
+        LOG_INFO("[%s] Plant died! Growth: %.1f, Water: %.1f, Nutrients: %.1f",
+                 getStateName(), growth, water, nutrients);
+    } else {
+        LOG_DEBUG("[%s -> %s] Growth: %.1f", getStateName(), stageName(next), growth);
+    }
+    stage = next;
+}
+
+PlantStage PlantState::getStage() const { return stage; }
+void PlantState::setStage(PlantStage s) { stage = s; }
+
+std::string PlantState::getState() const { return stageName(stage); }
+const char* PlantState::getStateName() const { return stageName(stage); }
 
-PlantState::~PlantState() {}
+bool PlantState::isRipe() const { return stage == PlantStage::Ripe; }
+bool PlantState::isDead() const { return stage == PlantStage::Dead; }
 
 float PlantState::getGrowth() const { return growth; }
 float PlantState::getWater() const { return water; }
 float PlantState::getNutrients() const { return nutrients; }
 
-void PlantState::setGrowth(float g) { 
-    growth = std::max(0.0f, g); 
+void PlantState::setGrowth(float g) {
+    growth = std::max(0.0f, g);
 }
 
-void PlantState::setWater(float w) { 
-    water = std::max(0.0f, w); 
+void PlantState::setWater(float w) {
+    water = std::max(0.0f, w);
 }
 
-void PlantState::setNutrients(float n) { 
-    nutrients = std::max(0.0f, n); 
+void PlantState::setNutrients(float n) {
+    nutrients = std::max(0.0f, n);
 }
 
 void PlantState::consumeResources(float waterConsumption, float nutrientConsumption) {
@@ -51,148 +75,119 @@ void PlantState::addNutrients(float amount) {
 }
 
 void PlantState::applyGrowth(float growthAmount) {
-    growth = std::min(GROWING_TO_RIPE_THRESHOLD, growth + growthAmount);
-}
-
-SeedState::SeedState() : PlantState(0.0f, 100.0f, 100.0f) {}
-SeedState::SeedState(float gr, float wa, float nu) : PlantState(gr, wa, nu) {}
-SeedState::SeedState(const SeedState& other) : PlantState(other) {}
-SeedState::~SeedState() {}
-
-float SeedState::getWaterConsumptionRate() const {
-    return WATER_CONSUMPTION_RATE * 0.5f;
-}
-
-float SeedState::getNutrientConsumptionRate() const {
-    return NUTRIENT_CONSUMPTION_RATE * 0.5f;
-}
-
-void SeedState::handle(Plant* plant) {
-    if (water <= DEATH_WATER_THRESHOLD || nutrients <= DEATH_NUTRIENT_THRESHOLD) {
-        std::cout << "[SEED] Plant died from lack of resources!" << std::endl;
-        plant->setState(new DeadState(growth, water, nutrients));
-        return;
-    }
-    
-    if (growth >= SEED_TO_GROWING_THRESHOLD) {
-        std::cout << "[SEED -> GROWING] Plant sprouted! Growth: " << growth << std::endl;
-        plant->setState(new GrowingState(growth, water, nutrients));
-        return;
-    }
-}
-
-void SeedState::tick(Plant* plant) {
-    consumeResources(getWaterConsumptionRate(), getNutrientConsumptionRate());
-    
-    if (water <= 10.0f || nutrients <= 10.0f) {
-        std::cout << "[SEED] Low resources! Water: " << water 
-                  << ", Nutrients: " << nutrients << std::endl;
+    growth = std::min(MAX_GROWTH, growth + growthAmount);
+}
+
+void PlantState::fastForward(uint32_t ticks, float growthPerTick)
+{
+    // No closed form here: n small adds and one n * step round differently,
+    // and callers compare a skipped plant with one that was stepped
+    for (; ticks > 0 && stage != PlantStage::Dead; ticks--)
+    {
+        tick();
+        if (stage != PlantStage::Dead)
+            applyGrowth(growthPerTick);
     }
-    
-    handle(plant);
 }
 
-std::string SeedState::getState() {
-    return "Seed";
+float PlantState::resourceAfter(float level, float use, uint32_t ticks)
+{
+    return ticks == 0 ? level : std::max(0.0f, level - (float)ticks * use);
 }
 
-GrowingState::GrowingState() : PlantState(25.0f, 100.0f, 100.0f) {}
-GrowingState::GrowingState(float gr, float wa, float nu) : PlantState(gr, wa, nu) {}
-GrowingState::GrowingState(const GrowingState& other) : PlantState(other) {}
-GrowingState::~GrowingState() {}
-
-float GrowingState::getWaterConsumptionRate() const {
-    return WATER_CONSUMPTION_RATE;
-}
-
-float GrowingState::getNutrientConsumptionRate() const {
-    return NUTRIENT_CONSUMPTION_RATE;
-}
-
-void GrowingState::handle(Plant* plant) {
-    if (water <= DEATH_WATER_THRESHOLD || nutrients <= DEATH_NUTRIENT_THRESHOLD) {
-        std::cout << "[GROWING] Plant died from lack of resources!" << std::endl;
-        plant->setState(new DeadState(growth, water, nutrients));
-        return;
-    }
-    
-    if (growth >= GROWING_TO_RIPE_THRESHOLD) {
-        std::cout << "[GROWING -> RIPE] Plant is ripe! Growth: " << growth << std::endl;
-        plant->setState(new RipeState(growth, water, nutrients));
-        return;
-    }
-}
-
-void GrowingState::tick(Plant* plant) {
-    consumeResources(getWaterConsumptionRate(), getNutrientConsumptionRate());
-    
-    if (water <= 5.0f || nutrients <= 5.0f) {
-        std::cout << "[GROWING] Warning! Low resources! Water: " << water 
-                  << ", Nutrients: " << nutrients << std::endl;
-    }
-    
-    handle(plant);
-}
-
-std::string GrowingState::getState() {
-    return "Growing";
-}
-RipeState::RipeState() : PlantState(100.0f, 100.0f, 100.0f) {}
-RipeState::RipeState(float gr, float wa, float nu) : PlantState(gr, wa, nu) {}
-RipeState::RipeState(const RipeState& other) : PlantState(other) {}
-RipeState::~RipeState() {}
-
-float RipeState::getWaterConsumptionRate() const {
-    return WATER_CONSUMPTION_RATE * 0.3f;
+float PlantState::growthAfter(float growth, float perTick, uint32_t ticks)
+{
+    return ticks == 0 ? growth : std::min(MAX_GROWTH, growth + (float)ticks * perTick);
 }
 
-float RipeState::getNutrientConsumptionRate() const {
-    return NUTRIENT_CONSUMPTION_RATE * 0.3f;
-}
+// First tick t >= 1 for which reached(t) holds, given a close estimate of
+// it. The estimate is nudged against reached() itself, so rounding in the
+// division can't put the event a tick off. reached() must stay true once true.
+template <typename Reached>
+static uint32_t firstTick(double estimate, Reached reached)
+{
+    const uint32_t limit = 1u << 30;
+    if (!(estimate < limit))
+        return PlantState::NO_EVENT;
 
-void RipeState::handle(Plant* plant) {
-    if (water <= DEATH_WATER_THRESHOLD || nutrients <= DEATH_NUTRIENT_THRESHOLD) {
-        std::cout << "[RIPE] Plant withered from lack of resources!" << std::endl;
-        plant->setState(new DeadState(growth, water, nutrients));
-        return;
+    uint32_t t = estimate < 1.0 ? 1 : (uint32_t)std::ceil(estimate);
+    while (t > 1 && reached(t - 1))
+        t--;
+    while (!reached(t))
+    {
+        if (++t >= limit)
+            return PlantState::NO_EVENT;
     }
-    
-    if (growth > 150.0f) {
-        std::cout << "[RIPE] Plant over-ripened and died!" << std::endl;
-        plant->setState(new DeadState(growth, water, nutrients));
-        return;
+    return t;
+}
+
+// The earliest of: water or nutrients running out or dropping to their
+// watch level, or growth reaching the stage's advance or wither point. A
+// tick judges the stage on the growth it starts with, so growth thresholds
+// look at t - 1.
+uint32_t PlantState::ticksToEvent(PlantStage s, float growth, float water, float nutrients, float growthPerTick,
+                                  float waterWatch, float nutrientWatch)
+{
+    if (s == PlantStage::Dead)
+        return NO_EVENT;
+
+    const StageRules& rules = RULES[(int)s];
+
+    auto fallsTo = [](float level, float use, float limit) -> uint32_t {
+        auto reached = [=](uint32_t t) { return resourceAfter(level, use, t) <= limit; };
+        if (reached(1))
+            return 1;
+        if (use <= 0.0f)
+            return NO_EVENT;
+        return firstTick((level - limit) / use, reached);
+    };
+    auto growsPast = [=](float target, bool strictly) -> uint32_t {
+        auto reached = [=](uint32_t t) {
+            const float at = growthAfter(growth, growthPerTick, t - 1);
+            return strictly ? at > target : at >= target;
+        };
+        if (reached(1))
+            return 1;
+        if (growthPerTick <= 0.0f || !reached(NO_EVENT))
+            return NO_EVENT;
+        return firstTick((target - growth) / growthPerTick + 1.0, reached);
+    };
+
+    uint32_t ticks = std::min(fallsTo(water, rules.waterUse, 0.0f), fallsTo(nutrients, rules.nutrientUse, 0.0f));
+    if (waterWatch > 0.0f && water > waterWatch)
+        ticks = std::min(ticks, fallsTo(water, rules.waterUse, waterWatch));
+    if (nutrientWatch > 0.0f && nutrients > nutrientWatch)
+        ticks = std::min(ticks, fallsTo(nutrients, rules.nutrientUse, nutrientWatch));
+    ticks = std::min(ticks, growsPast(rules.advanceAt, false));
+    ticks = std::min(ticks, growsPast(rules.witherAbove, true));
+    return ticks;
+}
+
+const char* PlantState::stageName(PlantStage s) {
+    switch (s) {
+    case PlantStage::Seed: return "Seed";
+    case PlantStage::Growing: return "Growing";
+    case PlantStage::Ripe: return "Ripe";
+    case PlantStage::Dead: return "Dead";
     }
+    return "Unknown";
 }
 
-void RipeState::tick(Plant* plant) {
-    consumeResources(getWaterConsumptionRate(), getNutrientConsumptionRate());
-    handle(plant);
+PlantStage PlantState::stageFromName(const std::string& name) {
+    if (name == "Growing") return PlantStage::Growing;
+    if (name == "Ripe") return PlantStage::Ripe;
+    if (name == "Dead") return PlantStage::Dead;
+    return PlantStage::Seed;
 }
 
-std::string RipeState::getState() {
-    return "Ripe";
-}
+SeedState::SeedState() : PlantState(0.0f, 100.0f, 100.0f, PlantStage::Seed) {}
+SeedState::SeedState(float gr, float wa, float nu) : PlantState(gr, wa, nu, PlantStage::Seed) {}
 
-DeadState::DeadState() : PlantState(0.0f, 0.0f, 0.0f) {}
-DeadState::DeadState(float gr, float wa, float nu) : PlantState(gr, wa, nu) {}
-DeadState::DeadState(const DeadState& other) : PlantState(other) {}
-DeadState::~DeadState() {}
+GrowingState::GrowingState() : PlantState(25.0f, 100.0f, 100.0f, PlantStage::Growing) {}
+GrowingState::GrowingState(float gr, float wa, float nu) : PlantState(gr, wa, nu, PlantStage::Growing) {}
 
-float DeadState::getWaterConsumptionRate() const {
-    return 0.0f;
-}
-
-float DeadState::getNutrientConsumptionRate() const {
-    return 0.0f;
-}
-
-void DeadState::handle(Plant* plant) {}
-
-void DeadState::tick(Plant* plant) {
-    growth = std::max(0.0f, growth - 0.5f);
-    handle(plant);
-}
+RipeState::RipeState() : PlantState(100.0f, 100.0f, 100.0f, PlantStage::Ripe) {}
+RipeState::RipeState(float gr, float wa, float nu) : PlantState(gr, wa, nu, PlantStage::Ripe) {}
 
-std::string DeadState::getState() {
-    return "Dead";
-}
\ No newline at end of file
+DeadState::DeadState() : PlantState(0.0f, 0.0f, 0.0f, PlantStage::Dead) {}
+DeadState::DeadState(float gr, float wa, float nu) : PlantState(gr, wa, nu, PlantStage::Dead) {}
@@ -1,73 +1,120 @@
 #pragma once
 #include <string>
+#include <cstdint>
+#include <limits>
 
-class Plant;
+enum class PlantStage : uint8_t
+{
+    Seed = 0,
+    Growing = 1,
+    Ripe = 2,
+    Dead = 3
+};
+
+// What a plant does in each stage, indexed by PlantStage
+struct StageRules
+{
+    float waterUse;       // consumed per tick
+    float nutrientUse;
+    float advanceAt;      // growth needed to move on to `next`
+    PlantStage next;
+    float witherAbove;    // growth above this kills the plant
+    float lowWarning;     // warn when water/nutrients drop to this (0 = never)
+};
 
+// Value type: the plant's stage plus its growth and resources.
+// Transitions just change `stage`, so ticking never allocates.
 class PlantState
 {
 public:
     PlantState();
-    PlantState(float gr, float wa, float nu);
-    PlantState(const PlantState& other); 
-    virtual ~PlantState() = 0;
-    
-    virtual void handle(Plant* plant) = 0;
-    virtual void tick(Plant* plant) = 0;
-    virtual std::string getState() = 0;
-    
+    PlantState(float gr, float wa, float nu, PlantStage stage = PlantStage::Seed);
+
+    // Consume resources and apply the stage transition for one tick
+    void tick();
+
+    PlantStage getStage() const;
+    void setStage(PlantStage s);
+    std::string getState() const;
+    const char* getStateName() const;
+    bool isRipe() const;
+    bool isDead() const;
+
     // Getters
     float getGrowth() const;
     float getWater() const;
     float getNutrients() const;
-    
+
     // Setters
     void setGrowth(float g);
     void setWater(float w);
     void setNutrients(float n);
-    
+
     // Resource management
     void consumeResources(float waterConsumption, float nutrientConsumption);
     void addWater(float amount);
     void addNutrients(float amount);
-    
-    // Growth application - called by GrowthCycle
+
+    // Growth application - the plant's growth per tick, from its GrowthCycle
     void applyGrowth(float growthAmount);
-    
+
+    // `ticks` ticks of a loose plant: tick(), then growthPerTick of growth
+    // while alive, replayed one by one so the result is bit-identical to
+    // stepping. A dead state is left as it is, as Plant::tick leaves it.
+    void fastForward(uint32_t ticks, float growthPerTick);
+
+    static const char* stageName(PlantStage s);
+    static PlantStage stageFromName(const std::string& name);
+
+    static constexpr float MAX_GROWTH = 100.0f;
+    static constexpr float DEAD_DECAY_PER_TICK = 0.5f;
+    static constexpr float NEVER = std::numeric_limits<float>::infinity();
+
+    // Seed/Growing/Ripe use half/full/0.3x of 2 water and 1 nutrient per tick
+    static constexpr StageRules RULES[4] = {
+        {1.0f, 0.5f, 25.0f, PlantStage::Growing, NEVER, 10.0f},   // Seed
+        {2.0f, 1.0f, 100.0f, PlantStage::Ripe, NEVER, 5.0f},      // Growing
+        {0.6f, 0.3f, NEVER, PlantStage::Ripe, 150.0f, 0.0f},      // Ripe
+        {0.0f, 0.0f, NEVER, PlantStage::Dead, NEVER, 0.0f}        // Dead
+    };
+
+    // Stage after a tick's consumption has left the plant at water/nutrients
+    // (resources gone or over-ripe -> dead, threshold reached -> next stage)
+    static constexpr PlantStage nextStage(PlantStage s, float growth, float water, float nutrients)
+    {
+        return (s == PlantStage::Dead || water <= 0.0f || nutrients <= 0.0f ||
+                growth > RULES[(int)s].witherAbove)
+                   ? PlantStage::Dead
+               : growth >= RULES[(int)s].advanceAt ? RULES[(int)s].next
+                                                   : s;
+    }
+
+    // Between events (a stage change, death, or water/nutrients dropping to
+    // a watched level) resources fall and growth rises in straight lines;
+    // these give the values `ticks` quiet ticks on
+    static float resourceAfter(float level, float use, uint32_t ticks);
+    static float growthAfter(float growth, float perTick, uint32_t ticks);
+
+    // Ticks until the next event, counting the event tick itself (>= 1), or
+    // NO_EVENT. Water or nutrients reaching a watch level count as events
+    // while they are above it.
+    static constexpr uint32_t NO_EVENT = UINT32_MAX;
+    static uint32_t ticksToEvent(PlantStage s, float growth, float water, float nutrients, float growthPerTick,
+                                 float waterWatch = 0.0f, float nutrientWatch = 0.0f);
+
 protected:
     float growth;
     float water;
     float nutrients;
-    
-    // Resource consumption rates per state
-    virtual float getWaterConsumptionRate() const = 0;
-    virtual float getNutrientConsumptionRate() const = 0;
-    
-    static const float SEED_TO_GROWING_THRESHOLD;
-    static const float GROWING_TO_RIPE_THRESHOLD;
-    static const float DEATH_WATER_THRESHOLD;
-    static const float DEATH_NUTRIENT_THRESHOLD;
-    static const float WATER_CONSUMPTION_RATE;
-    static const float NUTRIENT_CONSUMPTION_RATE;
-    static const float GROWTH_PER_TICK;
-
-    friend class Plant;
+    PlantStage stage;
 };
 
+// Convenience constructors for a plant that starts out in a given stage
 class SeedState : public PlantState
 {
 public:
     SeedState();
     SeedState(float gr, float wa, float nu);
-    SeedState(const SeedState& other);
-    virtual ~SeedState();
-    
-    void handle(Plant* plant) override;
-    void tick(Plant* plant) override;
-    std::string getState() override;
-    
-protected:
-    float getWaterConsumptionRate() const override;
-    float getNutrientConsumptionRate() const override;
 };
 
 class GrowingState : public PlantState
@@ -75,16 +122,6 @@ class GrowingState : public PlantState
 public:
     GrowingState();
     GrowingState(float gr, float wa, float nu);
-    GrowingState(const GrowingState& other); 
-    virtual ~GrowingState();
-    
-    void handle(Plant* plant) override;
-    void tick(Plant* plant) override;
-    std::string getState() override;
-    
-protected:
-    float getWaterConsumptionRate() const override;
-    float getNutrientConsumptionRate() const override;
 };
 
 class RipeState : public PlantState
@@ -92,16 +129,6 @@ class RipeState : public PlantState
 public:
     RipeState();
     RipeState(float gr, float wa, float nu);
-    RipeState(const RipeState& other); 
-    virtual ~RipeState();
-    
-    void handle(Plant* plant) override;
-    void tick(Plant* plant) override;
-    std::string getState() override;
-    
-protected:
-    float getWaterConsumptionRate() const override;
-    float getNutrientConsumptionRate() const override;
 };
 
 class DeadState : public PlantState
@@ -109,14 +136,4 @@ class DeadState : public PlantState
 public:
     DeadState();
     DeadState(float gr, float wa, float nu);
-    DeadState(const DeadState& other);
-    virtual ~DeadState();
-    
-    void handle(Plant* plant) override;
-    void tick(Plant* plant) override;
-    std::string getState() override;
-    
-protected:
-    float getWaterConsumptionRate() const override;
-    float getNutrientConsumptionRate() const override;
 };
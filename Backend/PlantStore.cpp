@@ -0,0 +1,387 @@
+#include "PlantStore.h"
+#include "Plant.h"
+#include "Logger.h"
+#include <algorithm>
+
+PlantStore::Chunk::Chunk()
+{
+    for (int i = 0; i < CHUNK_SIZE; i++)
+    {
+        growth[i] = 0.0f;
+        water[i] = 0.0f;
+        nutrients[i] = 0.0f;
+        growthPerTick[i] = 0.0f;
+        since[i] = 0;
+        due[i] = NEVER;
+        seenAt[i] = 0;
+        scheduledAt[i] = NEVER;
+        state[i] = EMPTY;
+        crossings[i] = 0;
+        dirty[i] = 0;
+    }
+}
+
+PlantStore::PlantStore(int capacity) : capacity(0), clock(0)
+{
+    for (int i = 0; i < MAX_CHUNKS; i++)
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    resize(capacity);
+}
+
+PlantStore::~PlantStore()
+{
+    for (int i = 0; i < MAX_CHUNKS; i++)
+        delete chunks[i].load(std::memory_order_relaxed);
+}
+
+void PlantStore::resize(int newCapacity)
+{
+    newCapacity = std::min(newCapacity, MAX_SLOTS);
+    if (newCapacity <= getCapacity())
+        return;
+
+    // Chunks are published before the capacity that lets anyone reach them
+    for (int c = 0; c * CHUNK_SIZE < newCapacity; c++)
+    {
+        if (chunks[c].load(std::memory_order_relaxed) == nullptr)
+            chunks[c].store(new Chunk(), std::memory_order_release);
+    }
+    capacity.store(newCapacity, std::memory_order_release);
+}
+
+int PlantStore::getCapacity() const
+{
+    return capacity.load(std::memory_order_acquire);
+}
+
+void PlantStore::bind(int slot, Plant* plant)
+{
+    if (slot < 0 || slot >= getCapacity() || !plant)
+        return;
+
+    // Growth rate first: load() works out the next event from it
+    chunkFor(slot).growthPerTick[offset(slot)] = plant->getGrowthPerTick();
+    load(slot, *plant->getPlantState());
+    plant->bindToStore(this, slot);
+}
+
+void PlantStore::release(int slot)
+{
+    if (slot < 0 || slot >= getCapacity())
+        return;
+
+    Chunk& chunk = chunkFor(slot);
+    const int i = offset(slot);
+    chunk.growth[i] = 0.0f;
+    chunk.water[i] = 0.0f;
+    chunk.nutrients[i] = 0.0f;
+    chunk.growthPerTick[i] = 0.0f;
+    chunk.since[i] = getNow();
+    // Any wake-up still in the wheel finds nothing to do
+    chunk.due[i] = NEVER;
+    chunk.state[i] = EMPTY;
+    chunk.crossings[i] = 0;
+    chunk.dirty[i] = 1;
+}
+
+void PlantStore::load(int slot, const PlantState& plantState)
+{
+    if (slot < 0 || slot >= getCapacity())
+        return;
+
+    Chunk& chunk = chunkFor(slot);
+    const int i = offset(slot);
+    chunk.growth[i] = plantState.getGrowth();
+    chunk.water[i] = plantState.getWater();
+    chunk.nutrients[i] = plantState.getNutrients();
+    chunk.state[i] = (uint8_t)plantState.getStage();
+    chunk.since[i] = getNow();
+    chunk.due[i] = nextEvent(chunk, i);
+    chunk.dirty[i] = 1;
+    scheduleWake(slot);
+}
+
+uint32_t PlantStore::getNow() const
+{
+    return clock.load(std::memory_order_acquire);
+}
+
+void PlantStore::advance(std::vector<int>& woken, uint32_t maxTicks)
+{
+    woken.clear();
+    std::lock_guard<std::mutex> lock(wheelMutex);
+    dueEntries.clear();
+    const uint32_t last = wheel.getNow() + std::min(maxTicks, NEVER - 1 - wheel.getNow());
+    wheel.advanceUntil(last, dueEntries);
+    clock.store(wheel.getNow(), std::memory_order_release);
+
+    for (const TimerWheel::Entry& entry : dueEntries)
+    {
+        // A slot can have older entries left over from before its event
+        // moved; only the one it's waiting on counts
+        uint32_t& scheduled = chunkFor(entry.id).scheduledAt[offset(entry.id)];
+        if (scheduled != entry.tick)
+            continue;
+        scheduled = NEVER;   // wake() books the next one
+        woken.push_back(entry.id);
+    }
+    // Plot order, so a tick's events come out the same however they were booked
+    std::sort(woken.begin(), woken.end());
+}
+
+void PlantStore::wake(int slot)
+{
+    if (slot < 0 || slot >= getCapacity())
+        return;
+    settle(slot, getNow());
+    scheduleWake(slot);
+}
+
+uint32_t PlantStore::getNextEvent(int slot) const
+{
+    return settle(slot, getNow()).due[offset(slot)];
+}
+
+void PlantStore::scheduleWake(int slot)
+{
+    const uint32_t due = chunkFor(slot).due[offset(slot)];
+    if (due == NEVER)
+        return;
+
+    std::lock_guard<std::mutex> lock(wheelMutex);
+    // The clock may have passed `due` while the caller worked it out; the
+    // wheel then wakes the slot next tick and settle() plays the event at
+    // its proper tick regardless
+    const uint32_t at = std::max(due, wheel.getNow() + 1);
+    uint32_t& scheduled = chunkFor(slot).scheduledAt[offset(slot)];
+    if (at < scheduled)
+    {
+        scheduled = at;
+        wheel.schedule(slot, at);
+    }
+}
+
+PlantStore::Chunk& PlantStore::settle(int slot, uint32_t now) const
+{
+    Chunk& chunk = chunkFor(slot);
+    const int i = offset(slot);
+    while (chunk.due[i] <= now)
+    {
+        const uint32_t at = chunk.due[i];
+        rebase(chunk, i, at - 1);
+        step(chunk, i);
+        chunk.since[i] = at;
+        chunk.due[i] = nextEvent(chunk, i);
+    }
+    return chunk;
+}
+
+void PlantStore::rebase(Chunk& chunk, int i, uint32_t tick)
+{
+    const uint32_t ticks = tick > chunk.since[i] ? tick - chunk.since[i] : 0;
+    if (ticks > 0 && chunk.state[i] < (uint8_t)PlantStage::Dead)
+    {
+        const StageRules& rules = PlantState::RULES[chunk.state[i]];
+        chunk.water[i] = PlantState::resourceAfter(chunk.water[i], rules.waterUse, ticks);
+        chunk.nutrients[i] = PlantState::resourceAfter(chunk.nutrients[i], rules.nutrientUse, ticks);
+        chunk.growth[i] = PlantState::growthAfter(chunk.growth[i], chunk.growthPerTick[i], ticks);
+    }
+    chunk.since[i] = std::max(chunk.since[i], tick);
+}
+
+// Same rules as Plant::tick (PlantState::tick, then the cycle's growth), driven
+// by the PlantState::RULES table: consume resources, pick the next stage from
+// the growth reached so far, then grow (capped at MAX_GROWTH) unless dead.
+// Threshold crossings are OR-ed into a byte per plot for the Greenhouse to
+// publish. Logs what PlantState::tick logs; since only event ticks are
+// stepped, the low-resource warning comes once per event rather than every
+// tick.
+void PlantStore::step(Chunk& chunk, int i)
+{
+    if (chunk.state[i] >= (uint8_t)PlantStage::Dead)
+        return;
+
+    const PlantStage stage = (PlantStage)chunk.state[i];
+    const StageRules& rules = PlantState::RULES[(int)stage];
+    const float waterBefore = chunk.water[i];
+    const float nutrientsBefore = chunk.nutrients[i];
+    chunk.dirty[i] = 1;
+
+    chunk.water[i] = std::max(0.0f, chunk.water[i] - rules.waterUse);
+    chunk.nutrients[i] = std::max(0.0f, chunk.nutrients[i] - rules.nutrientUse);
+
+    if (rules.lowWarning > 0.0f && (chunk.water[i] <= rules.lowWarning || chunk.nutrients[i] <= rules.lowWarning))
+    {
+        LOG_DEBUG("[%s] Low resources! Water: %.1f, Nutrients: %.1f", PlantState::stageName(stage), chunk.water[i],
+                  chunk.nutrients[i]);
+    }
+
+    const PlantStage next = PlantState::nextStage(stage, chunk.growth[i], chunk.water[i], chunk.nutrients[i]);
+    chunk.state[i] = (uint8_t)next;
+    if (next == PlantStage::Dead)
+    {
+        LOG_INFO("[%s] Plant died! Growth: %.1f, Water: %.1f, Nutrients: %.1f", PlantState::stageName(stage),
+                 chunk.growth[i], chunk.water[i], chunk.nutrients[i]);
+        return;
+    }
+    if (next != stage)
+    {
+        LOG_DEBUG("[%s -> %s] Growth: %.1f", PlantState::stageName(stage), PlantState::stageName(next),
+                  chunk.growth[i]);
+    }
+
+    chunk.growth[i] = std::min(PlantState::MAX_GROWTH, chunk.growth[i] + chunk.growthPerTick[i]);
+
+    if (waterBefore > NEEDS_WATER_AT && chunk.water[i] <= NEEDS_WATER_AT)
+        chunk.crossings[i] |= CROSSED_WATER;
+    if (nutrientsBefore > NEEDS_NUTRIENTS_AT && chunk.nutrients[i] <= NEEDS_NUTRIENTS_AT)
+        chunk.crossings[i] |= CROSSED_NUTRIENTS;
+    if (next == PlantStage::Ripe && stage != PlantStage::Ripe)
+        chunk.crossings[i] |= BECAME_RIPE;
+}
+
+// Closed-form tick of the next threshold, watching the NEEDS_* levels too
+uint32_t PlantStore::nextEvent(const Chunk& chunk, int i)
+{
+    if (chunk.state[i] >= (uint8_t)PlantStage::Dead)
+        return NEVER;
+
+    const uint32_t ticks = PlantState::ticksToEvent((PlantStage)chunk.state[i], chunk.growth[i], chunk.water[i],
+                                                    chunk.nutrients[i], chunk.growthPerTick[i],
+                                                    NEEDS_WATER_AT, NEEDS_NUTRIENTS_AT);
+    if (ticks == PlantState::NO_EVENT || ticks > NEVER - 1 - chunk.since[i])
+        return NEVER;
+    return chunk.since[i] + ticks;
+}
+
+void PlantStore::tick(int slot)
+{
+    if (slot < 0 || slot >= getCapacity())
+        return;
+    const uint32_t now = getNow();
+    Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    if (chunk.state[i] >= (uint8_t)PlantStage::Dead)
+        return;
+
+    // One tick ahead of the clock, for this plot alone
+    rebase(chunk, i, now);
+    step(chunk, i);
+    chunk.due[i] = nextEvent(chunk, i);
+    scheduleWake(slot);
+}
+
+void PlantStore::fastForward(int slot, uint32_t ticks)
+{
+    if (slot < 0 || slot >= getCapacity() || ticks == 0)
+        return;
+    const uint32_t now = getNow();
+    Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    if (chunk.state[i] >= (uint8_t)PlantStage::Dead)
+        return;
+
+    // Play the events as if the clock were already `ticks` on, then let the
+    // line start over from the real clock with the values reached
+    const uint32_t target = now + std::min(ticks, NEVER - 1 - now);
+    settle(slot, target);
+    rebase(chunk, i, target);
+    chunk.since[i] = now;
+    chunk.due[i] = nextEvent(chunk, i);
+    chunk.dirty[i] = 1;
+    scheduleWake(slot);
+}
+
+float PlantStore::getGrowth(int slot) const
+{
+    const uint32_t now = getNow();
+    const Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    if (chunk.state[i] >= (uint8_t)PlantStage::Dead)
+        return chunk.growth[i];
+    return PlantState::growthAfter(chunk.growth[i], chunk.growthPerTick[i], now > chunk.since[i] ? now - chunk.since[i] : 0);
+}
+
+float PlantStore::getWater(int slot) const
+{
+    const uint32_t now = getNow();
+    const Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    if (chunk.state[i] >= (uint8_t)PlantStage::Dead)
+        return chunk.water[i];
+    return PlantState::resourceAfter(chunk.water[i], PlantState::RULES[chunk.state[i]].waterUse, now > chunk.since[i] ? now - chunk.since[i] : 0);
+}
+
+float PlantStore::getNutrients(int slot) const
+{
+    const uint32_t now = getNow();
+    const Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    if (chunk.state[i] >= (uint8_t)PlantStage::Dead)
+        return chunk.nutrients[i];
+    return PlantState::resourceAfter(chunk.nutrients[i], PlantState::RULES[chunk.state[i]].nutrientUse, now > chunk.since[i] ? now - chunk.since[i] : 0);
+}
+
+float PlantStore::getGrowthPerTick(int slot) const { return chunkFor(slot).growthPerTick[offset(slot)]; }
+uint8_t PlantStore::getStateId(int slot) const { return settle(slot, getNow()).state[offset(slot)]; }
+
+void PlantStore::addWater(int slot, float amount)
+{
+    const uint32_t now = getNow();
+    Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    rebase(chunk, i, now);
+    chunk.water[i] = std::min(100.0f, chunk.water[i] + amount);
+    chunk.due[i] = nextEvent(chunk, i);
+    chunk.dirty[i] = 1;
+    scheduleWake(slot);
+}
+
+void PlantStore::addNutrients(int slot, float amount)
+{
+    const uint32_t now = getNow();
+    Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    rebase(chunk, i, now);
+    chunk.nutrients[i] = std::min(100.0f, chunk.nutrients[i] + amount);
+    chunk.due[i] = nextEvent(chunk, i);
+    chunk.dirty[i] = 1;
+    scheduleWake(slot);
+}
+
+void PlantStore::setGrowthPerTick(int slot, float amount)
+{
+    const uint32_t now = getNow();
+    Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    rebase(chunk, i, now);
+    chunk.growthPerTick[i] = amount;
+    chunk.due[i] = nextEvent(chunk, i);
+    chunk.dirty[i] = 1;
+    scheduleWake(slot);
+}
+
+uint8_t PlantStore::takeCrossings(int slot)
+{
+    Chunk& chunk = settle(slot, getNow());
+    uint8_t bits = chunk.crossings[offset(slot)];
+    chunk.crossings[offset(slot)] = 0;
+    return bits;
+}
+
+void PlantStore::markDirty(int slot)
+{
+    chunkFor(slot).dirty[offset(slot)] = 1;
+}
+
+bool PlantStore::takeDirty(int slot)
+{
+    const uint32_t now = getNow();
+    Chunk& chunk = settle(slot, now);
+    const int i = offset(slot);
+    // A live plot moves every tick without anything being written
+    const bool moved = chunk.dirty[i] != 0 || (chunk.state[i] < (uint8_t)PlantStage::Dead && chunk.seenAt[i] != now);
+    chunk.dirty[i] = 0;
+    chunk.seenAt[i] = now;
+    return moved;
+}
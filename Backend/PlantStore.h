@@ -0,0 +1,151 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "PlantState.h"
+#include "TimerWheel.h"
+
+class Plant;
+
+// Structure-of-arrays storage for the plants growing in a Greenhouse.
+// Every plot's simulation data (growth, water, nutrients, growth per tick and
+// state id) sits in its own contiguous array instead of behind
+// Plant -> PlantState pointers. A Plant placed in a plot
+// becomes a thin handle that reads and writes through to its slot here.
+//
+// Plots are simulated by event rather than by polling. Between thresholds
+// a plot's water and nutrients fall and its growth rises linearly, so each
+// slot keeps its values as of the tick they were last settled plus the tick
+// of its next event (a stage change, death, or water or nutrients dropping
+// to the NEEDS_* level), worked out in closed form. Reads evaluate the line
+// at the current tick. advance() moves the clock and hands back only the
+// slots whose event came up, from a TimerWheel; an event tick is played
+// with the same rules as PlantState::tick. Idle plots cost nothing per tick.
+//
+// Slots come in chunks of CHUNK_SIZE that are made as the store grows and
+// never move afterwards, so growing it doesn't disturb threads using the
+// slots that already exist. Each array is contiguous within a chunk.
+class PlantStore
+{
+public:
+    // State ids are PlantStage values; empty plots use one past Dead
+    static constexpr uint8_t EMPTY = 4;
+
+    // Thresholds workers react to, and the per-slot bits set when a plot
+    // crosses one (collected and cleared by takeCrossings)
+    static constexpr float NEEDS_WATER_AT = 20.0f;
+    static constexpr float NEEDS_NUTRIENTS_AT = 20.0f;
+    static constexpr uint8_t CROSSED_WATER = 1;
+    static constexpr uint8_t CROSSED_NUTRIENTS = 2;
+    static constexpr uint8_t BECAME_RIPE = 4;
+
+    // Event tick of a plot that has nothing coming (dead or empty)
+    static constexpr uint32_t NEVER = PlantState::NO_EVENT;
+
+    static constexpr int CHUNK_SIZE = 64;
+    static constexpr int MAX_CHUNKS = 64;
+    static constexpr int MAX_SLOTS = CHUNK_SIZE * MAX_CHUNKS;
+
+    PlantStore(int capacity = 0);
+    ~PlantStore();
+
+    PlantStore(const PlantStore&) = delete;
+    PlantStore& operator=(const PlantStore&) = delete;
+
+    // Grows to `capacity` slots (at most MAX_SLOTS); never shrinks.
+    // Call from one thread at a time.
+    void resize(int capacity);
+    int getCapacity() const;
+
+    // Copies the plant's current state into the slot and binds the plant to it
+    void bind(int slot, Plant* plant);
+    // Marks the slot empty (the plant copies its data back out first)
+    void release(int slot);
+
+    // Current simulation tick
+    uint32_t getNow() const;
+    // Moves the clock on one tick and fills `woken` with the slots that
+    // have an event due. Each should then get wake() under its plot's lock.
+    // With maxTicks > 1 the clock runs on over quiet ticks, up to maxTicks,
+    // and stops at the first tick with an event: the same as that many
+    // single advances, minus the empty ones. Called from the one thread
+    // driving the simulation.
+    void advance(std::vector<int>& woken, uint32_t maxTicks = 1);
+    // Plays a woken slot's due events and schedules its next one
+    void wake(int slot);
+    // Tick of the slot's next event, or NEVER
+    uint32_t getNextEvent(int slot) const;
+
+    // Ages a single plot by one tick on its own (Plant::tick on a planted plant)
+    void tick(int slot);
+    // Ages a single plot by `ticks` ticks on its own, in closed form
+    void fastForward(int slot, uint32_t ticks);
+
+    // Overwrites a slot from a standalone PlantState
+    void load(int slot, const PlantState& state);
+
+    float getGrowth(int slot) const;
+    float getWater(int slot) const;
+    float getNutrients(int slot) const;
+    float getGrowthPerTick(int slot) const;
+    uint8_t getStateId(int slot) const;
+
+    void addWater(int slot, float amount);
+    void addNutrients(int slot, float amount);
+    void setGrowthPerTick(int slot, float amount);
+
+    // Returns the CROSSED_* / BECAME_RIPE bits gathered since the last call
+    uint8_t takeCrossings(int slot);
+
+    // True if a slot's data changed since the last call (events, watering,
+    // bind/release, or simply growing while the clock moved), so delta
+    // saves only write the plots that moved since the last one
+    void markDirty(int slot);
+    bool takeDirty(int slot);
+
+private:
+    struct Chunk
+    {
+        // Values as of tick `since`; valid until tick `due`
+        alignas(64) float growth[CHUNK_SIZE];
+        alignas(64) float water[CHUNK_SIZE];
+        alignas(64) float nutrients[CHUNK_SIZE];
+        alignas(64) float growthPerTick[CHUNK_SIZE];
+        uint32_t since[CHUNK_SIZE];
+        uint32_t due[CHUNK_SIZE];
+        uint32_t seenAt[CHUNK_SIZE];        // clock at the last takeDirty
+        uint32_t scheduledAt[CHUNK_SIZE];   // earliest wheel entry that counts; guarded by wheelMutex
+        uint8_t state[CHUNK_SIZE];
+        uint8_t crossings[CHUNK_SIZE];
+        uint8_t dirty[CHUNK_SIZE];
+
+        Chunk();
+    };
+
+    std::atomic<Chunk*> chunks[MAX_CHUNKS];
+    std::atomic<int> capacity;
+    std::atomic<uint32_t> clock;
+
+    std::mutex wheelMutex;   // the wheel is fed from any thread that tends a plot
+    TimerWheel wheel;
+    std::vector<TimerWheel::Entry> dueEntries;   // reused between ticks
+
+    // slot must be below getCapacity()
+    Chunk& chunkFor(int slot) const { return *chunks[slot / CHUNK_SIZE].load(std::memory_order_acquire); }
+    static int offset(int slot) { return slot % CHUNK_SIZE; }
+
+    // Per-slot helpers. Callers hold the slot's plot lock, which is what
+    // makes settling on a read safe.
+    // Plays every event due by `now`, so the line from `since` holds again
+    Chunk& settle(int slot, uint32_t now) const;
+    // Moves `since` up to `tick` (no event may lie in between)
+    static void rebase(Chunk& chunk, int i, uint32_t tick);
+    // One tick of PlantState::tick rules applied to the stored values
+    static void step(Chunk& chunk, int i);
+    // Closed-form tick of the next threshold from the stored values
+    static uint32_t nextEvent(const Chunk& chunk, int i);
+    // Makes sure the wheel wakes the slot no later than its `due` tick
+    void scheduleWake(int slot);
+};
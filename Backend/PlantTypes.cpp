@@ -0,0 +1,154 @@
+#include "PlantTypes.h"
+#include "Plant.h"
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace
+{
+struct Registry
+{
+    // Names never move once written, so name() can read without the lock
+    std::string names[PlantTypes::MAX_TYPES];
+    PlantDescriptor types[PlantTypes::MAX_TYPES];
+    bool isCrop[PlantTypes::MAX_TYPES];
+    std::atomic<int> issued;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, PlantTypeId> others;   // names after the built-ins
+
+    Registry() : issued(PlantTypes::BUILT_IN_COUNT)
+    {
+        for (int id = 0; id < PlantTypes::MAX_TYPES; id++)
+        {
+            types[id] = PlantDescriptor{"", 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, (PlantTypeId)id};
+            isCrop[id] = false;
+        }
+        for (int id = 0; id < PlantTypes::BUILT_IN_COUNT; id++)
+        {
+            names[id] = PlantTypes::BUILT_IN[id].name;
+            types[id] = PlantTypes::BUILT_IN[id];
+            isCrop[id] = true;
+        }
+    }
+};
+
+// Made on first use, so plants built during static initialisation still
+// find the built-ins in place
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+}
+
+PlantTypeId PlantTypes::intern(std::string_view name)
+{
+    PlantTypeId id = builtIn(name);
+    if (id != NONE)
+        return id;
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::string key(name);
+    auto found = r.others.find(key);
+    if (found != r.others.end())
+        return found->second;
+
+    int next = r.issued.load(std::memory_order_relaxed);
+    if (next >= MAX_TYPES)
+        return NONE;
+
+    r.names[next] = key;
+    r.types[next].name = r.names[next].c_str();
+    r.issued.store(next + 1, std::memory_order_release);
+    r.others.emplace(std::move(key), (PlantTypeId)next);
+    return (PlantTypeId)next;
+}
+
+PlantTypeId PlantTypes::find(std::string_view name)
+{
+    PlantTypeId id = builtIn(name);
+    if (id != NONE)
+        return id;
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto found = r.others.find(std::string(name));
+    return found != r.others.end() ? found->second : NONE;
+}
+
+const std::string& PlantTypes::name(PlantTypeId id)
+{
+    static const std::string none;
+    Registry& r = registry();
+    if (id >= r.issued.load(std::memory_order_acquire))
+        return none;
+    return r.names[id];
+}
+
+int PlantTypes::count()
+{
+    return registry().issued.load(std::memory_order_acquire);
+}
+
+const PlantDescriptor* PlantTypes::describe(PlantTypeId id)
+{
+    Registry& r = registry();
+    if (id >= r.issued.load(std::memory_order_acquire) || !r.isCrop[id])
+        return nullptr;
+    return &r.types[id];
+}
+
+PlantTypeId PlantTypes::add(const PlantDescriptor& descriptor)
+{
+    PlantTypeId id = intern(descriptor.name);
+    if (id == NONE)
+        return NONE;
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.types[id] = descriptor;
+    r.types[id].name = r.names[id].c_str();
+    if (descriptor.look == NONE || describe(descriptor.look) == nullptr)
+        r.types[id].look = id;
+    r.isCrop[id] = true;
+    return id;
+}
+
+int PlantTypes::loadFile(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return -1;
+
+    int added = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream fields(line);
+        std::string typeName;
+        std::string lookName;
+        PlantDescriptor descriptor = {};
+        if (!(fields >> typeName >> descriptor.growthRate >> descriptor.sellPrice >> descriptor.seedPrice >>
+              descriptor.width >> descriptor.height))
+            continue;
+        descriptor.look = (fields >> lookName) ? find(lookName) : NONE;
+        descriptor.name = typeName.c_str();
+        if (add(descriptor) != NONE)
+            added++;
+    }
+    return added;
+}
+
+Plant* PlantTypes::create(PlantTypeId id)
+{
+    if (describe(id) == nullptr)
+        return nullptr;
+    return new Plant(id, PlantVisualFactory::getInstance().getVisual(id));
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Plant type names interned to small integer ids, so hot paths (inventory
+// stacking, counts) compare and index by number instead of by string.
+// The built-in crops hold fixed ids 0..BUILT_IN_COUNT-1; other names get
+// the next ids in first-seen order. Ids stay valid for the process.
+typedef uint16_t PlantTypeId;
+
+class Plant;
+
+// Everything the game knows about one crop. Plants, saves, the seed shop
+// and the renderer all read it by id instead of keeping their own copies.
+struct PlantDescriptor
+{
+    const char* name;
+    float growthRate;   // base rate; see GrowthCycle::growthPerTick
+    float sellPrice;
+    float seedPrice;
+    float width;        // full-grown drawing size, as a fraction of a plot
+    float height;
+    PlantTypeId look;   // type whose visual strategy draws it
+};
+
+namespace PlantTypes
+{
+const PlantTypeId NONE = 0xFFFF;
+const int MAX_TYPES = 256;
+
+enum BuiltIn : PlantTypeId
+{
+    LETTUCE,
+    CARROT,
+    POTATO,
+    CUCUMBER,
+    TOMATO,
+    PEPPER,
+    SUNFLOWER,
+    STRAWBERRY,
+    CORN,
+    PUMPKIN,
+    BUILT_IN_COUNT
+};
+
+constexpr PlantDescriptor BUILT_IN[BUILT_IN_COUNT] = {
+    {"Lettuce", 1.6f, 15.0f, 15.0f, 0.8f, 1.0f, LETTUCE},
+    {"Carrot", 1.4f, 25.0f, 25.0f, 0.8f, 1.0f, CARROT},
+    {"Potato", 1.2f, 35.0f, 35.0f, 0.8f, 1.0f, POTATO},
+    {"Cucumber", 1.1f, 45.0f, 45.0f, 0.8f, 1.0f, CUCUMBER},
+    {"Tomato", 1.0f, 55.0f, 55.0f, 0.8f, 1.0f, TOMATO},
+    {"Pepper", 0.9f, 65.0f, 65.0f, 0.8f, 1.0f, PEPPER},
+    {"Sunflower", 0.8f, 80.0f, 80.0f, 0.8f, 1.0f, SUNFLOWER},
+    {"Strawberry", 0.7f, 100.0f, 100.0f, 0.8f, 1.0f, STRAWBERRY},
+    {"Corn", 0.6f, 120.0f, 120.0f, 0.8f, 1.0f, CORN},
+    {"Pumpkin", 0.5f, 200.0f, 200.0f, 0.8f, 1.0f, PUMPKIN},
+};
+
+// Compile-time perfect hash over the built-in names: a seed is searched
+// for until every name lands in its own slot, so a lookup is one hash and
+// one comparison to reject names that aren't built in.
+namespace detail
+{
+constexpr int HASH_SLOTS = 32;
+
+constexpr uint32_t hash(std::string_view name, uint32_t seed)
+{
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : name)
+    {
+        h ^= (uint8_t)c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+constexpr bool separates(uint32_t seed)
+{
+    bool used[HASH_SLOTS] = {};
+    for (const PlantDescriptor& type : BUILT_IN)
+    {
+        const uint32_t slot = hash(type.name, seed) % HASH_SLOTS;
+        if (used[slot])
+            return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t findSeed()
+{
+    uint32_t seed = 0;
+    while (!separates(seed))
+        seed++;
+    return seed;
+}
+
+constexpr uint32_t SEED = findSeed();
+
+struct Slots
+{
+    PlantTypeId ids[HASH_SLOTS];
+};
+
+constexpr Slots buildSlots()
+{
+    Slots slots = {};
+    for (int i = 0; i < HASH_SLOTS; i++)
+        slots.ids[i] = NONE;
+    for (int id = 0; id < BUILT_IN_COUNT; id++)
+        slots.ids[hash(BUILT_IN[id].name, SEED) % HASH_SLOTS] = (PlantTypeId)id;
+    return slots;
+}
+
+constexpr Slots SLOTS = buildSlots();
+}
+
+// Id of a built-in crop by name, or NONE. Usable in constant expressions.
+constexpr PlantTypeId builtIn(std::string_view name)
+{
+    const PlantTypeId id = detail::SLOTS.ids[detail::hash(name, detail::SEED) % detail::HASH_SLOTS];
+    return id != NONE && name == BUILT_IN[id].name ? id : NONE;
+}
+
+static_assert(builtIn("Pumpkin") == PUMPKIN && builtIn("Lettuce") == LETTUCE && builtIn("Weed") == NONE,
+              "built-in names hash to their own ids");
+
+// Id for the name, adding it on first use. Safe from any thread.
+PlantTypeId intern(std::string_view name);
+// Id for the name, or NONE if it was never seen
+PlantTypeId find(std::string_view name);
+// "" for NONE; the reference stays valid for the process
+const std::string& name(PlantTypeId id);
+// Ids issued so far: every id is below this
+int count();
+
+// The crop with this id, or nullptr for NONE and names that aren't crops
+const PlantDescriptor* describe(PlantTypeId id);
+// Adds a crop, or replaces one with the same name, and returns its id.
+// Call at startup, before any plant of the type is made.
+PlantTypeId add(const PlantDescriptor& descriptor);
+// Reads crops from a text file, one per line:
+//   name growthRate sellPrice seedPrice width height [look]
+// where look names the type whose visuals it borrows (itself by default).
+// Blank lines and lines starting with '#' are skipped. Returns the number
+// of crops added, or -1 if the file can't be opened.
+int loadFile(const std::string& path);
+
+// A fresh plant of the type, or nullptr if it isn't a crop
+Plant* create(PlantTypeId id);
+}
@@ -3,7 +3,9 @@
 #include <sstream>
 #include <iomanip> 
 #include <iostream>
+#ifndef TEMPLANTER_HEADLESS
 #include "../Frontend/InventoryUI.h"
+#endif
 
 // bool Player::safe = true;
 
@@ -13,27 +15,34 @@ Player::Player()
 {
     inventory = new Inventory(25); // Changed from 15 to 25 slots
     plot = new Greenhouse(inventory);
+#ifndef TEMPLANTER_HEADLESS
     inventoryUI = new InventoryUI(inventory);
+#else
+    inventoryUI = nullptr;
+#endif
 }
 
 Player::~Player()
 {
     if (inventory)
     {
-        delete inventory;
-    if (plot)
-        delete plot;
+    // Workers go first: a batch still running in the pool may touch the plot
     for (auto worker : workers)
     {
         if (worker)
             delete worker;
     }
     workers.clear();
+        delete inventory;
+    if (plot)
+        delete plot;
     }
+#ifndef TEMPLANTER_HEADLESS
     if (inventoryUI)
     {
         delete inventoryUI;
     }
+#endif
 }
 
 Inventory *Player::getInventory() const
@@ -72,16 +81,7 @@ void Player::UpdateGameTime(float dt)
 {
     const float REAL_SECONDS_PER_GAME_MINUTE = 1.0f;
 
-    int speedMultiplier = 1;
-
-    if (hour >= 20 || hour < 6 || isProtected())
-    {
-        speedMultiplier = 10;
-    }
-    else
-    {
-        speedMultiplier = 1;
-    }
+    int speedMultiplier = getTimeScale();
     timeAccumulator += dt * (float)speedMultiplier;
     if (timeAccumulator >= REAL_SECONDS_PER_GAME_MINUTE)
     {
@@ -94,6 +94,15 @@ void Player::UpdateGameTime(float dt)
     }
 }
 
+int Player::getTimeScale() const
+{
+    if (hour >= 20 || hour < 6 || safe)
+    {
+        return 10;
+    }
+    return 1;
+}
+
 float Player::getRating() const
 {
     return rating;
@@ -208,7 +217,11 @@ void Player::pauseWorkers()
 
 void Player::startWorkers()
 {
-
+    for (auto* worker : workers) {
+        if (worker) {
+            worker->start();
+        }
+    }
 }
 
 const std::vector<Worker *> &Player::getWorkers()
@@ -235,6 +248,28 @@ Memento *Player::createMemento() const
     return new Memento(invData, workersData, ghData, money, rating, day, hour, minute);
 }
 
+Memento *Player::createCheckpoint()
+{
+    // Forget older changes first: anything that moves while we serialize is
+    // marked again and lands in the next delta
+    plot->takeDirtyPlots();
+    inventory->takeDirtySlots();
+    return createMemento();
+}
+
+Memento *Player::createDeltaMemento()
+{
+    std::vector<int> plots = plot->takeDirtyPlots();
+    // Marks and contents in one step: workers may be harvesting into it
+    std::vector<std::pair<int, InventorySlot>> stacks = inventory->takeDirtyStacks();
+
+    std::string invData = Serializer::serializeInventory(inventory, &stacks);
+    std::string workersData = Serializer::serializeWorkers(workers);
+    std::string ghData = Serializer::serializeGreenhouse(plot, &plots);
+
+    return new Memento(invData, workersData, ghData, money, rating, day, hour, minute, SaveFormat::VERSION, true);
+}
+
 void Player::setMemento(Memento *memento)
 {
     if (memento)
@@ -254,14 +289,30 @@ void Player::setMemento(Memento *memento)
         day = memento->getDay();
         hour = memento->getHour();
         minute = memento->getMinute();
-        inventory->clear();
-
-        Serializer::deserializeInventory(inventory, memento->getInventoryData());
-        Serializer::deserializeGreenhouse(plot, memento->getGreenhouseData());
 
-     
+        // Binary payloads are parsed where they are (possibly a mapped file)
+        if (memento->isDelta())
+        {
+            Serializer::applyInventoryDelta(inventory, memento->readInventory(), memento->getFormat());
+            Serializer::applyGreenhouseDelta(plot, memento->readGreenhouse(), memento->getFormat());
+        }
+        else if (memento->getFormat() == SaveFormat::LEGACY_TEXT)
+        {
+            inventory->clear();
+            Serializer::deserializeInventory(inventory, memento->getInventoryData(), memento->getFormat());
+            Serializer::deserializeGreenhouse(plot, memento->getGreenhouseData(), memento->getFormat());
+        }
+        else
+        {
+            inventory->clear();
+            Serializer::deserializeInventory(inventory, memento->readInventory(), memento->getFormat());
+            Serializer::deserializeGreenhouse(plot, memento->readGreenhouse(), memento->getFormat());
+        }
 
-        Serializer::deserializeWorkers(workers, memento->getWorkerData());
+        if (memento->getFormat() == SaveFormat::LEGACY_TEXT)
+            Serializer::deserializeWorkers(workers, memento->getWorkerData(), memento->getFormat());
+        else
+            Serializer::deserializeWorkers(workers, memento->readWorkers());
 
         for (auto *worker : workers)
         {
@@ -2,11 +2,16 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
 #include "Inventory.h"
 #include "Greenhouse.h"
 #include "Worker.h"
 #include "Memento.h"
+#ifndef TEMPLANTER_HEADLESS
 #include "../Frontend/InventoryUI.h" // <<< Final Check: InventoryUI included >>>
+#else
+class InventoryUI;
+#endif
 
 class Player 
 {
@@ -30,6 +35,7 @@ public:
     void setTime(int d, int h, int m);
     void advanceTime(int minutes);
     void UpdateGameTime(float dt); // <<< UpdateGameTime added >>>
+    int getTimeScale() const; // 10x at night and while patrolling
 
     // <<< Final Check: Inventory UI Getter >>>
     InventoryUI* getInventoryUI() const { return inventoryUI; }
@@ -51,6 +57,11 @@ public:
     bool isProtected();
 
     Memento* createMemento() const;
+    // Autosave chain: a checkpoint is a full memento that also starts change
+    // tracking afresh; each delta holds only what changed since the previous
+    // checkpoint or delta. setMemento() applies either kind.
+    Memento* createCheckpoint();
+    Memento* createDeltaMemento();
     void setMemento(Memento* memento);
 
 private:
@@ -59,7 +70,7 @@ private:
     int day;
     int hour;
     int minute;
-    bool safe;
+    std::atomic<bool> safe;   // set by every worker after each command
     
     float timeAccumulator; // <<< timeAccumulator added >>>
     
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include "PlotHandle.h"
+
+// Something a worker may want to act on, published by the Greenhouse for the
+// plots that crossed a threshold during a tick (see PlantStore::NEEDS_*_AT).
+// Only the handle is carried: the plant may be replaced before it is read.
+enum class PlotEventType : uint8_t
+{
+    NeedsWater,
+    NeedsNutrients,
+    Ripe
+};
+
+struct PlotEvent
+{
+    PlotEventType type;
+    PlotHandle plot;
+};
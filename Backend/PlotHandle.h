@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+
+// Stable reference to whatever occupies a greenhouse plot.
+// The Greenhouse bumps a plot's generation every time a plant is planted in
+// it or leaves it, so a handle taken earlier stops resolving once that plant
+// is harvested, removed or replaced: no scan, and no dangling Plant*.
+struct PlotHandle
+{
+    int index = -1;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index < 0; }
+    bool operator==(const PlotHandle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const PlotHandle& other) const { return !(*this == other); }
+};
@@ -0,0 +1,230 @@
+#include "SaveFormat.h"
+#include <cstring>
+
+uint32_t SaveFormat::crc32(const char* data, size_t size, uint32_t crc)
+{
+    struct Table
+    {
+        uint32_t entries[256];
+        Table()
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t c = i;
+                for (int bit = 0; bit < 8; bit++)
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                entries[i] = c;
+            }
+        }
+    };
+    static const Table table; // built once, thread-safe
+
+    crc = ~crc;
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+        crc = table.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+BinaryWriter::BinaryWriter(size_t reserve)
+{
+    buffer.reserve(reserve);
+}
+
+void BinaryWriter::writeU8(uint8_t value)
+{
+    buffer.push_back((char)value);
+}
+
+void BinaryWriter::writeU16(uint16_t value)
+{
+    char bytes[2] = {(char)(value & 0xFF), (char)(value >> 8)};
+    buffer.append(bytes, 2);
+}
+
+void BinaryWriter::writeU32(uint32_t value)
+{
+    char bytes[4] = {(char)(value & 0xFF), (char)((value >> 8) & 0xFF),
+                     (char)((value >> 16) & 0xFF), (char)(value >> 24)};
+    buffer.append(bytes, 4);
+}
+
+void BinaryWriter::writeU64(uint64_t value)
+{
+    writeU32((uint32_t)(value & 0xFFFFFFFFu));
+    writeU32((uint32_t)(value >> 32));
+}
+
+void BinaryWriter::writeI32(int32_t value)
+{
+    writeU32((uint32_t)value);
+}
+
+void BinaryWriter::writeF32(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(bits);
+}
+
+void BinaryWriter::writeFixed16(float value)
+{
+    float scaled = value * 256.0f + 0.5f;
+    if (scaled < 0.0f)
+        scaled = 0.0f;
+    if (scaled > 65535.0f)
+        scaled = 65535.0f;
+    writeU16((uint16_t)scaled);
+}
+
+void BinaryWriter::writeBytes(const void* data, size_t size)
+{
+    buffer.append((const char*)data, size);
+}
+
+void BinaryWriter::writeName(const std::string& name)
+{
+    size_t length = name.size() > 255 ? 255 : name.size();
+    writeU8((uint8_t)length);
+    buffer.append(name.data(), length);
+}
+
+void BinaryWriter::patchU16(size_t offset, uint16_t value)
+{
+    buffer[offset] = (char)(value & 0xFF);
+    buffer[offset + 1] = (char)(value >> 8);
+}
+
+void BinaryWriter::patchU32(size_t offset, uint32_t value)
+{
+    buffer[offset] = (char)(value & 0xFF);
+    buffer[offset + 1] = (char)((value >> 8) & 0xFF);
+    buffer[offset + 2] = (char)((value >> 16) & 0xFF);
+    buffer[offset + 3] = (char)(value >> 24);
+}
+
+size_t BinaryWriter::beginSection(uint16_t id)
+{
+    writeU16(id);
+    size_t mark = buffer.size();
+    writeU32(0);
+    return mark;
+}
+
+void BinaryWriter::endSection(size_t mark)
+{
+    patchU32(mark, (uint32_t)(buffer.size() - mark - 4));
+}
+
+std::string BinaryWriter::release()
+{
+    std::string out;
+    out.swap(buffer);
+    return out;
+}
+
+BinaryReader::BinaryReader() : cursor(nullptr), end(nullptr), good(true)
+{
+}
+
+BinaryReader::BinaryReader(const char* data, size_t size)
+    : cursor((const unsigned char*)data), end((const unsigned char*)data + size), good(true)
+{
+}
+
+BinaryReader::BinaryReader(const std::string& data)
+    : BinaryReader(data.data(), data.size())
+{
+}
+
+bool BinaryReader::need(size_t size)
+{
+    if (!good || (size_t)(end - cursor) < size)
+    {
+        good = false;
+        return false;
+    }
+    return true;
+}
+
+uint8_t BinaryReader::readU8()
+{
+    if (!need(1))
+        return 0;
+    return *cursor++;
+}
+
+uint16_t BinaryReader::readU16()
+{
+    if (!need(2))
+        return 0;
+    uint16_t value = (uint16_t)(cursor[0] | (cursor[1] << 8));
+    cursor += 2;
+    return value;
+}
+
+uint32_t BinaryReader::readU32()
+{
+    if (!need(4))
+        return 0;
+    uint32_t value = (uint32_t)cursor[0] | ((uint32_t)cursor[1] << 8) |
+                     ((uint32_t)cursor[2] << 16) | ((uint32_t)cursor[3] << 24);
+    cursor += 4;
+    return value;
+}
+
+uint64_t BinaryReader::readU64()
+{
+    uint64_t low = readU32();
+    uint64_t high = readU32();
+    return low | (high << 32);
+}
+
+int32_t BinaryReader::readI32()
+{
+    return (int32_t)readU32();
+}
+
+float BinaryReader::readF32()
+{
+    uint32_t bits = readU32();
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+float BinaryReader::readFixed16()
+{
+    return readU16() / 256.0f;
+}
+
+bool BinaryReader::readName(const char*& text, size_t& length)
+{
+    length = readU8();
+    if (!need(length))
+        return false;
+    text = (const char*)cursor;
+    cursor += length;
+    return true;
+}
+
+void BinaryReader::skip(size_t size)
+{
+    if (need(size))
+        cursor += size;
+}
+
+bool BinaryReader::nextSection(uint16_t& id, BinaryReader& body)
+{
+    if (!good || cursor == end)
+        return false;
+
+    id = readU16();
+    uint32_t length = readU32();
+    if (!need(length))
+        return false;
+
+    body = BinaryReader((const char*)cursor, length);
+    cursor += length;
+    return true;
+}
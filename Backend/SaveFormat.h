@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Binary save format.
+// Everything is little-endian and fixed width regardless of the host. A file
+// is a small header followed by length-prefixed sections:
+//
+//   u32 magic ("TPLS")  u16 version  u16 section count
+//   summary (version 2+, fixed size, see below)
+//   repeat: u16 section id  u32 payload length  payload bytes
+//
+// The summary is what a load menu shows, so slots can be listed by reading
+// HEADER_SIZE bytes per file:
+//
+//   u32 CRC-32 of every byte after the header   u64 saved at (unix seconds)
+//   i32 day  u8 hour  u8 minute  u16 plants in the greenhouse  f32 money
+//
+// Readers skip section ids they don't know, so new sections can be added
+// without bumping the version. Bump VERSION when an existing payload changes.
+namespace SaveFormat
+{
+const uint32_t MAGIC = 0x534C5054; // "TPLS" on disk
+const uint16_t VERSION = 4;
+const uint16_t FIRST_VERSION_WITH_SUMMARY = 2;
+const uint16_t FIRST_VERSION_WITH_COUNTED_STACKS = 3;   // inventory stacks are (type, count)
+const uint16_t FIRST_VERSION_WITH_FLOAT_PLANTS = 4;     // plant growth/water/nutrients are f32, not 8.8
+const int LEGACY_TEXT = 0;         // pre-binary "KEY:value" text saves
+
+const size_t PREAMBLE_SIZE = 8;    // magic, version, section count
+const size_t SUMMARY_SIZE = 24;
+const size_t HEADER_SIZE = PREAMBLE_SIZE + SUMMARY_SIZE;
+
+// Standard CRC-32 (as zlib/PNG); pass the previous result to continue a run
+uint32_t crc32(const char* data, size_t size, uint32_t crc = 0);
+
+enum SectionId : uint16_t
+{
+    SECTION_META = 1,       // money, rating, clock
+    SECTION_INVENTORY = 2,
+    SECTION_GREENHOUSE = 3,
+    SECTION_WORKERS = 4,
+    SECTION_DELTA = 5       // empty marker: payloads are deltas (journal records only)
+};
+
+// Autosave journal: deltas appended after a checkpoint save
+//   u32 magic ("TPLJ")  u16 version  u16 unused  u32 checksum of the checkpoint
+//   repeat: u32 length  a complete save image (with its own checksum)
+// A torn last record from a crash fails its checksum and ends the replay.
+const uint32_t JOURNAL_MAGIC = 0x4A4C5054; // "TPLJ" on disk
+const size_t JOURNAL_HEADER_SIZE = 12;
+}
+
+// Appends little-endian fields to a byte buffer
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(size_t reserve = 0);
+
+    void writeU8(uint8_t value);
+    void writeU16(uint16_t value);
+    void writeU32(uint32_t value);
+    void writeU64(uint64_t value);
+    void writeI32(int32_t value);
+    void writeF32(float value);
+    // 8.8 fixed point (0 to 255.996, steps of 1/256): plant percentages before version 4
+    void writeFixed16(float value);
+    void writeBytes(const void* data, size_t size);
+    // u8 length + bytes, for short names (longer strings are cut at 255)
+    void writeName(const std::string& name);
+
+    // For counts that are only known after the records are written
+    size_t getSize() const { return buffer.size(); }
+    void patchU16(size_t offset, uint16_t value);
+    void patchU32(size_t offset, uint32_t value);
+
+    // Writes a section header with a placeholder length; endSection() patches it
+    size_t beginSection(uint16_t id);
+    void endSection(size_t mark);
+
+    const std::string& getData() const { return buffer; }
+    std::string release();
+
+private:
+    std::string buffer;
+};
+
+// Bounds-checked reads over a byte range it does not own. Reading past the
+// end returns zeros and clears ok(), so callers check once at the end.
+class BinaryReader
+{
+public:
+    BinaryReader();
+    BinaryReader(const char* data, size_t size);
+    explicit BinaryReader(const std::string& data);
+
+    uint8_t readU8();
+    uint16_t readU16();
+    uint32_t readU32();
+    uint64_t readU64();
+    int32_t readI32();
+    float readF32();
+    float readFixed16();
+    // Name bytes stay in the source buffer: no copy
+    bool readName(const char*& text, size_t& length);
+    void skip(size_t size);
+
+    // Next "id, length, payload" section; body reads just that payload
+    bool nextSection(uint16_t& id, BinaryReader& body);
+
+    bool ok() const { return good; }
+    size_t remaining() const { return (size_t)(end - cursor); }
+    const char* position() const { return (const char*)cursor; }
+
+private:
+    bool need(size_t size);
+
+    const unsigned char* cursor;
+    const unsigned char* end;
+    bool good;
+};
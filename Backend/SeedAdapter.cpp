@@ -3,6 +3,10 @@
 SeedAdapter::SeedAdapter(float seedPrice, std::function<Plant*()> factory)
     : price(seedPrice), plantFactory(factory) {}
 
+SeedAdapter::SeedAdapter(PlantTypeId type)
+    : price(PlantTypes::describe(type) ? PlantTypes::describe(type)->seedPrice : 0.0f),
+      plantFactory([type]() { return PlantTypes::create(type); }) {}
+
 SeedAdapter::~SeedAdapter() {}
 
 float SeedAdapter::getPrice() const 
@@ -12,6 +12,8 @@ private:
     
 public:
     SeedAdapter(float seedPrice, std::function<Plant*()> factory);
+    // Seeds of a registered crop, at its seed price
+    explicit SeedAdapter(PlantTypeId type);
     ~SeedAdapter();
     
     float getPrice() const override;
@@ -6,8 +6,454 @@
 #include "PlantState.h"
 #include <sstream>
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
+// Plant types come from the PlantTypes registry and are stored by id. Files
+// carry their own name table, so ids can change without breaking old saves.
+namespace
+{
+// Worker kinds as stored in a save (u8), indexed by kind
+const char *const WORKER_KINDS[] = {"Manager/Generic Worker", "Water Worker", "Fertiliser Worker", "Harvest Worker"};
+const int WORKER_KIND_COUNT = (int)(sizeof(WORKER_KINDS) / sizeof(WORKER_KINDS[0]));
+
+// Bytes per stored plant: stage, then growth, water, nutrients as f32.
+// Before version 4 they were 8.8 fixed point, which is what the per-item
+// inventory records of version 2 saves still hold.
+const size_t PLANT_RECORD_SIZE = 1 + 3 * 4;
+const size_t FIXED16_PLANT_RECORD_SIZE = 1 + 3 * 2;
+
+// Type id a delta uses for a plot or slot that is now empty (no record follows)
+const uint8_t EMPTY_TYPE = 0xFF;
+}
+
+int Serializer::plantTypeIndex(PlantTypeId type)
+{
+    // Type ids are stored in a byte, with EMPTY_TYPE kept back
+    if (type >= EMPTY_TYPE || PlantTypes::describe(type) == nullptr)
+        return -1;
+    return type;
+}
+
+Plant *Serializer::createPlant(int typeIndex)
+{
+    if (typeIndex < 0)
+        return nullptr;
+    return PlantTypes::create((PlantTypeId)typeIndex);
+}
+
+uint8_t Serializer::workerKindFromName(const char *type)
+{
+    for (int i = 1; i < WORKER_KIND_COUNT; i++)
+    {
+        if (std::strcmp(type, WORKER_KINDS[i]) == 0)
+            return (uint8_t)i;
+    }
+    return 0;
+}
+
+Worker *Serializer::createWorker(uint8_t kind)
+{
+    switch (kind)
+    {
+    case 1:
+        return new WaterWorker();
+    case 2:
+        return new FertiliserWorker();
+    case 3:
+        return new HarvestWorker();
+    default:
+        return new Worker();
+    }
+}
+
+void Serializer::writePlantTypes(BinaryWriter &out)
+{
+    const int count = std::min(PlantTypes::count(), (int)EMPTY_TYPE);
+    out.writeU8((uint8_t)count);
+    for (int id = 0; id < count; id++)
+    {
+        out.writeName(PlantTypes::name((PlantTypeId)id));
+    }
+}
+
+void Serializer::readPlantTypes(BinaryReader &in, int *remap)
+{
+    for (int i = 0; i < 256; i++)
+        remap[i] = -1;
+
+    int count = in.readU8();
+    for (int i = 0; i < count; i++)
+    {
+        const char *name;
+        size_t length;
+        if (!in.readName(name, length))
+            return;
+        remap[i] = plantTypeIndex(PlantTypes::find(std::string_view(name, length)));
+    }
+}
+
+void Serializer::writePlant(BinaryWriter &out, Plant *plant)
+{
+    // One sync from the store for all four fields
+    const PlantState *state = plant->getPlantState();
+    out.writeU8((uint8_t)state->getStage());
+    out.writeF32(state->getGrowth());
+    out.writeF32(state->getWater());
+    out.writeF32(state->getNutrients());
+}
+
+Plant *Serializer::readPlant(BinaryReader &in, int typeIndex, int format)
+{
+    uint8_t stage = in.readU8();
+    float growth, water, nutrients;
+    if (format < SaveFormat::FIRST_VERSION_WITH_FLOAT_PLANTS)
+    {
+        growth = in.readFixed16();
+        water = in.readFixed16();
+        nutrients = in.readFixed16();
+    }
+    else
+    {
+        growth = in.readF32();
+        water = in.readF32();
+        nutrients = in.readF32();
+    }
+
+    if (!in.ok() || stage > (uint8_t)PlantStage::Dead)
+        return nullptr;
+
+    Plant *plant = createPlant(typeIndex);
+    if (plant)
+        plant->setState(PlantState(growth, water, nutrients, (PlantStage)stage));
+    return plant;
+}
+
+// Inventory payload: type table, u16 stack count, then per stack
+// u16 slot index, u8 type, u16 item count (before version 3, a plant
+// record per item followed)
+std::string Serializer::serializeInventory(Inventory *inventory,
+                                          const std::vector<std::pair<int, InventorySlot>> *onlyStacks)
+{
+    if (!inventory)
+        return "";
+
+    // Read under the inventory's lock in one go, so harvests landing while
+    // we write can't leave the payload half before and half after them
+    const std::vector<InventorySlot> all = onlyStacks ? std::vector<InventorySlot>() : inventory->getSlots();
+    const size_t slotCount = onlyStacks ? onlyStacks->size() : all.size();
+    BinaryWriter out(64 + slotCount * 5);
+    writePlantTypes(out);
+
+    size_t countAt = out.getSize();
+    out.writeU16(0);
+    uint16_t stacks = 0;
+
+    for (size_t n = 0; n < slotCount; ++n)
+    {
+        const size_t i = onlyStacks ? (size_t)(*onlyStacks)[n].first : n;
+        const InventorySlot &slot = onlyStacks ? (*onlyStacks)[n].second : all[n];
+        // (a type missing from the catalogue can't be restored either way)
+        if (slot.isEmpty() || (onlyStacks && plantTypeIndex(slot.getPlantTypeId()) < 0))
+        {
+            // A delta has to say the slot emptied
+            if (onlyStacks)
+            {
+                out.writeU16((uint16_t)i);
+                out.writeU8(EMPTY_TYPE);
+                out.writeU16(0);
+                stacks++;
+            }
+            continue;
+        }
+
+        out.writeU16((uint16_t)i);
+        out.writeU8((uint8_t)plantTypeIndex(slot.getPlantTypeId()));
+        out.writeU16((uint16_t)slot.getSize());
+        stacks++;
+    }
+    out.patchU16(countAt, stacks);
+
+    return out.release();
+}
+
+void Serializer::deserializeInventory(Inventory *inventory, const std::string &data, int format)
+{
+    if (format == SaveFormat::LEGACY_TEXT)
+    {
+        deserializeInventoryText(inventory, data);
+        return;
+    }
+    deserializeInventory(inventory, BinaryReader(data), format);
+}
+
+PlantTypeId Serializer::stackType(int typeIndex)
+{
+    return typeIndex < 0 ? PlantTypes::NONE : (PlantTypeId)typeIndex;
+}
+
+void Serializer::deserializeInventory(Inventory *inventory, BinaryReader in, int format)
+{
+    if (!inventory || in.remaining() == 0)
+        return;
+
+    inventory->clear();
+
+    int remap[256];
+    readPlantTypes(in, remap);
+
+    int stacks = in.readU16();
+    for (int s = 0; s < stacks && in.ok(); s++)
+    {
+        size_t slotIndex = in.readU16();
+        PlantTypeId type = stackType(remap[in.readU8()]);
+        int count = in.readU16();
+        if (format < SaveFormat::FIRST_VERSION_WITH_COUNTED_STACKS)
+            in.skip(count * FIXED16_PLANT_RECORD_SIZE); // per-item state, no longer kept
+        if (!in.ok() || type == PlantTypes::NONE)
+            continue;
+
+        // Back into the same slot, so the player's layout survives a load
+        int placed = inventory->addToSpecificSlot(type, count, slotIndex);
+        inventory->add(type, count - placed);
+    }
+}
+
+// Greenhouse payload: type table, u16 capacity, u16 planted count, then
+// per planted plot u16 plot index, u8 type and a plant record (empty plots cost nothing)
+std::string Serializer::serializeGreenhouse(Greenhouse *greenhouse, const std::vector<int> *onlyPlots)
+{
+    if (!greenhouse)
+        return "";
+
+    const int capacity = greenhouse->getCapacity();
+    const int plotCount = onlyPlots ? (int)onlyPlots->size() : capacity;
+    BinaryWriter out(64 + plotCount * (3 + PLANT_RECORD_SIZE));
+    writePlantTypes(out);
+    out.writeU16((uint16_t)capacity);
+
+    size_t countAt = out.getSize();
+    out.writeU16(0);
+    uint16_t planted = 0;
+
+    for (int n = 0; n < plotCount; ++n)
+    {
+        const int i = onlyPlots ? (*onlyPlots)[n] : n;
+        // Workers may be tending the plot while we save, so read it locked
+        bool written = false;
+        greenhouse->withPlant(greenhouse->getHandle(i), [&](Plant *plant) {
+            if (onlyPlots && plantTypeIndex(plant->getTypeId()) < 0)
+                return; // written as empty below, like the inventory
+            out.writeU16((uint16_t)i);
+            out.writeU8((uint8_t)plantTypeIndex(plant->getTypeId()));
+            writePlant(out, plant);
+            planted++;
+            written = true;
+        });
+        if (!written && onlyPlots)
+        {
+            out.writeU16((uint16_t)i);
+            out.writeU8(EMPTY_TYPE);
+            planted++;
+        }
+    }
+    out.patchU16(countAt, planted);
+
+    return out.release();
+}
+
+void Serializer::clearGreenhouse(Greenhouse *greenhouse)
+{
+    // Detach all observers first to prevent notify() during cleanup
+    std::vector<Observer*> observersBackup = greenhouse->observers;
+    greenhouse->observers.clear();
+    
+    // Now safely remove plants without triggering notifications
+    for (int i = 0; i < greenhouse->getCapacity(); ++i)
+    {
+        greenhouse->removePlant(i);
+    }
+    
+    // Re-attach observers
+    greenhouse->observers = observersBackup;
+}
+
+void Serializer::applyInventoryDelta(Inventory *inventory, BinaryReader in, int format)
+{
+    if (!inventory || in.remaining() == 0)
+        return;
+
+    int remap[256];
+    readPlantTypes(in, remap);
+
+    int stacks = in.readU16();
+    for (int s = 0; s < stacks && in.ok(); s++)
+    {
+        size_t slotIndex = in.readU16();
+        uint8_t typeId = in.readU8();
+        int count = in.readU16();
+
+        inventory->clearSlot(slotIndex);
+        PlantTypeId type = (typeId == EMPTY_TYPE) ? PlantTypes::NONE : stackType(remap[typeId]);
+        if (format < SaveFormat::FIRST_VERSION_WITH_COUNTED_STACKS)
+            in.skip(count * FIXED16_PLANT_RECORD_SIZE);
+        if (!in.ok() || type == PlantTypes::NONE)
+            continue;
+
+        int placed = inventory->addToSpecificSlot(type, count, slotIndex);
+        inventory->add(type, count - placed);
+    }
+}
+
+void Serializer::applyGreenhouseDelta(Greenhouse *greenhouse, BinaryReader in, int format)
+{
+    if (!greenhouse || in.remaining() == 0)
+        return;
+
+    int remap[256];
+    readPlantTypes(in, remap);
+
+    int capacity = in.readU16();
+    if (capacity > greenhouse->getCapacity())
+        greenhouse->increaseCapacity(capacity - greenhouse->getCapacity());
+
+    int changed = in.readU16();
+    for (int p = 0; p < changed && in.ok(); p++)
+    {
+        int position = in.readU16();
+        uint8_t typeId = in.readU8();
+
+        greenhouse->removePlant(position);
+        if (typeId == EMPTY_TYPE)
+            continue;
+
+        Plant *plant = readPlant(in, remap[typeId], format);
+        if (plant && !greenhouse->addPlant(plant, position))
+        {
+            delete plant;
+        }
+    }
+}
+
+int Serializer::countGreenhousePlants(BinaryReader in)
+{
+    if (in.remaining() == 0)
+        return 0;
+
+    int remap[256];
+    readPlantTypes(in, remap);
+    in.readU16(); // capacity
+    int planted = in.readU16();
+    return in.ok() ? planted : 0;
+}
+
+void Serializer::deserializeGreenhouse(Greenhouse *greenhouse, const std::string &data, int format)
+{
+    if (format == SaveFormat::LEGACY_TEXT)
+    {
+        deserializeGreenhouseText(greenhouse, data);
+        return;
+    }
+    deserializeGreenhouse(greenhouse, BinaryReader(data), format);
+}
+
+void Serializer::deserializeGreenhouse(Greenhouse *greenhouse, BinaryReader in, int format)
+{
+    if (!greenhouse || in.remaining() == 0)
+        return;
+
+    clearGreenhouse(greenhouse);
+
+    int remap[256];
+    readPlantTypes(in, remap);
+
+    int capacity = in.readU16();
+    if (capacity > greenhouse->getCapacity())
+        greenhouse->increaseCapacity(capacity - greenhouse->getCapacity());
+
+    int planted = in.readU16();
+    for (int p = 0; p < planted && in.ok(); p++)
+    {
+        int position = in.readU16();
+        int type = remap[in.readU8()];
+        Plant *plant = readPlant(in, type, format);
+        if (plant && !greenhouse->addPlant(plant, position))
+        {
+            delete plant;
+        }
+    }
+}
+
+// Workers payload: u16 count, then per worker u8 kind and u8 level
+std::string Serializer::serializeWorkers(const std::vector<Worker *> &workers)
+{
+    if (workers.empty())
+        return "";
+
+    BinaryWriter out(2 + workers.size() * 2);
+    size_t countAt = out.getSize();
+    out.writeU16(0);
+    uint16_t count = 0;
+
+    for (const auto *worker : workers)
+    {
+        if (worker)
+        {
+            out.writeU8(workerKindFromName(worker->type()));
+            out.writeU8((uint8_t)worker->getLevel());
+            count++;
+        }
+    }
+    out.patchU16(countAt, count);
+
+    return out.release();
+}
+
+void Serializer::clearWorkers(std::vector<Worker *> &workers)
+{
+    for (auto worker : workers)
+    {
+        if (worker)
+            delete worker;
+    }
+    workers.clear();
+}
+
+void Serializer::deserializeWorkers(std::vector<Worker *> &workers, const std::string &data, int format)
+{
+    if (format == SaveFormat::LEGACY_TEXT)
+    {
+        deserializeWorkersText(workers, data);
+        return;
+    }
+    deserializeWorkers(workers, BinaryReader(data));
+}
+
+void Serializer::deserializeWorkers(std::vector<Worker *> &workers, BinaryReader in)
+{
+    clearWorkers(workers);
+
+    if (in.remaining() == 0)
+        return;
+
+    int count = in.readU16();
+    for (int i = 0; i < count; i++)
+    {
+        uint8_t kind = in.readU8();
+        uint8_t level = in.readU8();
+        if (!in.ok())
+            break;
+
+        Worker *worker = createWorker(kind);
+        worker->setLevel(level);
+        workers.push_back(worker);
+    }
+}
+
+// =============================================================================
+// Pre-binary text saves (read only, for loading old game_state.txt files)
+// =============================================================================
+
 std::vector<std::string> Serializer::split(const std::string &str, char delimiter)
 {
     std::vector<std::string> tokens;
@@ -36,26 +482,7 @@ std::string Serializer::join(const std::vector<std::string> &parts, char delimit
     return result;
 }
 
-std::string Serializer::serializePlant(Plant *plant)
-{
-    if (!plant)
-        return "NULL";
-
-    PlantState *state = plant->getPlantState();
-    std::stringstream ss;
-
-    ss << plant->getType() << "|"
-       << plant->getBaseGrowthRate() << "|"
-       << plant->getSellPrice() << "|"
-       << (state ? state->getState() : "Seed") << "|"
-       << (state ? state->getGrowth() : 0.0f) << "|"
-       << (state ? state->getWater() : 100.0f) << "|"
-       << (state ? state->getNutrients() : 100.0f);
-
-    return ss.str();
-}
-
-Plant *Serializer::deserializePlant(const std::string &plantData)
+Plant *Serializer::deserializePlantText(const std::string &plantData)
 {
     if (plantData == "NULL")
     {
@@ -78,62 +505,11 @@ Plant *Serializer::deserializePlant(const std::string &plantData)
         float water = std::stof(parts[5]);
         float nutrients = std::stof(parts[6]);
 
-        Plant *plant = nullptr;
-
-        if (type == "Lettuce")
-            plant = new Lettuce(new LettuceVisualStrategy(20.0f, 15.0f));
-        else if (type == "Tomato")
-            plant = new Tomato(new TomatoVisualStrategy(25.0f, 25.0f));
-        else if (type == "Carrot")
-            plant = new Carrot(new CarrotVisualStrategy(15.0f, 30.0f));
-        else if (type == "Pumpkin")
-            plant = new Pumpkin(new PumpkinVisualStrategy(40.0f, 30.0f));
-        else if (type == "Strawberry")
-            plant = new Strawberry(new StrawberryVisualStrategy(25.0f, 15.0f));
-        else if (type == "Potato")
-            plant = new Potato(new PotatoVisualStrategy(18.0f, 20.0f));
-        else if (type == "Cucumber")
-            plant = new Cucumber(new CucumberVisualStrategy(20.0f, 35.0f));
-        else if (type == "Pepper")
-            plant = new Pepper(new PepperVisualStrategy(25.0f, 30.0f));
-        else if (type == "Sunflower")
-            plant = new Sunflower(new SunflowerVisualStrategy(25.0f, 50.0f));
-        else if (type == "Corn")
-            plant = new Corn(new CornVisualStrategy(20.0f, 55.0f));
-        else
-        {
-            return nullptr;
-        }
-
+        Plant *plant = createPlant(plantTypeIndex(PlantTypes::find(type)));
         if (!plant)
             return nullptr;
 
-        PlantState *newState = nullptr;
-        if (stateName == "Seed")
-        {
-            newState = new SeedState(growth, water, nutrients);
-        }
-        else if (stateName == "Growing")
-        {
-            newState = new GrowingState(growth, water, nutrients);
-        }
-        else if (stateName == "Ripe")
-        {
-            newState = new RipeState(growth, water, nutrients);
-        }
-        else if (stateName == "Dead")
-        {
-            newState = new DeadState(growth, water, nutrients);
-        }
-        else
-        {
-            newState = new SeedState(growth, water, nutrients);
-        }
-
-        if (newState)
-        {
-            plant->setState(newState);
-        }
+        plant->setState(PlantState(growth, water, nutrients, PlantState::stageFromName(stateName)));
 
         return plant;
     }
@@ -147,45 +523,7 @@ Plant *Serializer::deserializePlant(const std::string &plantData)
     }
 }
 
-std::string Serializer::serializeInventory(Inventory *inventory)
-{
-    if (!inventory)
-        return "";
-
-    std::stringstream ss;
-    std::vector<std::string> allPlants;
-
-    for (size_t i = 0; i < inventory->getStackCount(); ++i)
-    {
-        const InventorySlot *slot = inventory->getSlot(i);
-        if (slot && slot->getSize() > 0)
-        {
-            for (int j = 0; j < slot->getSize(); ++j)
-            {
-                Plant *plant = slot->getPlant(j);
-                if (plant)
-                {
-                    allPlants.push_back(serializePlant(plant));
-                }
-                else
-                {
-                    allPlants.push_back(slot->getPlantType() + "|1.6|15.0|Seed|0.0|100.0|100.0");
-                }
-            }
-        }
-    }
-
-    for (size_t i = 0; i < allPlants.size(); ++i)
-    {
-        ss << allPlants[i];
-        if (i < allPlants.size() - 1)
-            ss << "|";
-    }
-
-    return ss.str();
-}
-
-void Serializer::deserializeInventory(Inventory *inventory, const std::string &data)
+void Serializer::deserializeInventoryText(Inventory *inventory, const std::string &data)
 {
     if (!inventory || data.empty())
         return;
@@ -209,7 +547,7 @@ void Serializer::deserializeInventory(Inventory *inventory, const std::string &d
         {
             std::string plantData = parts[i] + "|" + parts[i + 1] + "|" + parts[i + 2] + "|" + parts[i + 3] + "|" + parts[i + 4] + "|" + parts[i + 5] + "|" + parts[i + 6];
 
-            Plant *plant = deserializePlant(plantData);
+            Plant *plant = deserializePlantText(plantData);
             if (plant)
             {
                 if (inventory->add(plant))
@@ -229,50 +567,12 @@ void Serializer::deserializeInventory(Inventory *inventory, const std::string &d
     }
 }
 
-std::string Serializer::serializeGreenhouse(Greenhouse *greenhouse)
-{
-    if (!greenhouse)
-        return "";
-
-    std::stringstream ss;
-
-    ss << greenhouse->getSize() << ","
-       << greenhouse->getCapacity() << "|";
-
-    std::vector<std::string> plants;
-    for (int i = 0; i < greenhouse->getCapacity(); ++i)
-    {
-        Plant *plant = greenhouse->getPlant(i);
-        plants.push_back(serializePlant(plant));
-    }
-
-    for (size_t i = 0; i < plants.size(); ++i)
-    {
-        ss << plants[i];
-        if (i < plants.size() - 1)
-            ss << "|";
-    }
-
-    return ss.str();
-}
-
-void Serializer::deserializeGreenhouse(Greenhouse *greenhouse, const std::string &data)
+void Serializer::deserializeGreenhouseText(Greenhouse *greenhouse, const std::string &data)
 {
     if (!greenhouse || data.empty())
         return;
 
-    // Detach all observers first to prevent notify() during cleanup
-    std::vector<Observer*> observersBackup = greenhouse->observers;
-    greenhouse->observers.clear();
-    
-    // Now safely remove plants without triggering notifications
-    for (int i = 0; i < greenhouse->getCapacity(); ++i)
-    {
-        greenhouse->removePlant(i);
-    }
-    
-    // Re-attach observers
-    greenhouse->observers = observersBackup;
+    clearGreenhouse(greenhouse);
 
     try
     {
@@ -299,7 +599,7 @@ void Serializer::deserializeGreenhouse(Greenhouse *greenhouse, const std::string
             {
                 std::string plantData = parts[plantIndex] + "|" + parts[plantIndex + 1] + "|" + parts[plantIndex + 2] + "|" + parts[plantIndex + 3] + "|" + parts[plantIndex + 4] + "|" + parts[plantIndex + 5] + "|" + parts[plantIndex + 6];
                 
-                Plant *plant = deserializePlant(plantData);
+                Plant *plant = deserializePlantText(plantData);
                 
                 if (plant)
                 {
@@ -319,41 +619,9 @@ void Serializer::deserializeGreenhouse(Greenhouse *greenhouse, const std::string
 }
 }
 
-std::string Serializer::serializeWorkers(const std::vector<Worker *> &workers)
-{
-    if (workers.empty())
-        return "";
-
-    std::stringstream ss;
-    std::vector<std::string> workerData;
-
-    for (const auto *worker : workers)
-    {
-        if (worker)
-        {
-            std::string workerType = worker->type();
-            workerData.push_back(workerType);
-        }
-    }
-
-    for (size_t i = 0; i < workerData.size(); ++i)
-    {
-        ss << workerData[i];
-        if (i < workerData.size() - 1)
-            ss << "|";
-    }
-
-    return ss.str();
-}
-
-void Serializer::deserializeWorkers(std::vector<Worker *> &workers, const std::string &data)
+void Serializer::deserializeWorkersText(std::vector<Worker *> &workers, const std::string &data)
 {
-    for (auto worker : workers)
-    {
-        if (worker)
-            delete worker;
-    }
-    workers.clear();
+    clearWorkers(workers);
 
     if (data.empty())
         return;
@@ -364,24 +632,7 @@ void Serializer::deserializeWorkers(std::vector<Worker *> &workers, const std::s
 
         for (const auto &workerType : workerTypes)
         {
-            Worker *newWorker = nullptr;
-
-            if (workerType == "Water Worker")
-            {
-                newWorker = new WaterWorker();
-            }
-            else if (workerType == "Fertiliser Worker")
-            {
-                newWorker = new FertiliserWorker();
-            }
-            else if (workerType == "Harvest Worker")
-            {
-                newWorker = new HarvestWorker();
-            }
-            else
-            {
-                newWorker = new Worker();
-            }
+            Worker *newWorker = createWorker(workerKindFromName(workerType.c_str()));
 
             if (newWorker)
             {
@@ -1,34 +1,75 @@
 #ifndef SERIALIZER_H
 #define SERIALIZER_H
 
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
+#include "SaveFormat.h"
+#include "PlantTypes.h"
 
 class Inventory;
+class InventorySlot;
 class Greenhouse;
 class Worker;
 class Plant;
 class PlantState;
 
+// Turns game objects into the binary section payloads described in
+// SaveFormat.h and back. Loaders also accept old text payloads when the
+// Memento says it came from a legacy save.
 class Serializer {
 public:
-    static std::string serializeInventory(Inventory* inventory);
-    static std::string serializeGreenhouse(Greenhouse* greenhouse);
+    // With a list (of stacks from Inventory::takeDirtyStacks, or of plot
+    // indices) only those slots/plots are written, empty ones included,
+    // which makes a delta payload for the apply*Delta loaders
+    static std::string serializeInventory(Inventory* inventory,
+                                          const std::vector<std::pair<int, InventorySlot>>* onlyStacks = nullptr);
+    static std::string serializeGreenhouse(Greenhouse* greenhouse, const std::vector<int>* onlyPlots = nullptr);
     static std::string serializeWorkers(const std::vector<Worker*>& workers);
     
-    static void deserializeInventory(Inventory* inventory, const std::string& data);
-    static void deserializeGreenhouse(Greenhouse* greenhouse, const std::string& data);
-    static void deserializeWorkers(std::vector<Worker*>& workers, const std::string& data);
+    static void deserializeInventory(Inventory* inventory, const std::string& data, int format = SaveFormat::VERSION);
+    static void deserializeGreenhouse(Greenhouse* greenhouse, const std::string& data, int format = SaveFormat::VERSION);
+    static void deserializeWorkers(std::vector<Worker*>& workers, const std::string& data, int format = SaveFormat::VERSION);
+
+    // Binary payloads read in place (e.g. straight out of a mapped save file).
+    // format is the save's version, for payloads that changed between them.
+    static void deserializeInventory(Inventory* inventory, BinaryReader in, int format = SaveFormat::VERSION);
+    static void deserializeGreenhouse(Greenhouse* greenhouse, BinaryReader in, int format = SaveFormat::VERSION);
+    static void deserializeWorkers(std::vector<Worker*>& workers, BinaryReader in);
+
+    // Replace just the slots/plots listed in a delta payload
+    static void applyInventoryDelta(Inventory* inventory, BinaryReader in, int format = SaveFormat::VERSION);
+    static void applyGreenhouseDelta(Greenhouse* greenhouse, BinaryReader in, int format = SaveFormat::VERSION);
+
+    // Plants in a binary greenhouse payload, read from its header (for save summaries)
+    static int countGreenhousePlants(BinaryReader in);
 
 private:
-    static std::string serializePlant(Plant* plant);
-    static Plant* deserializePlant(const std::string& plantData);
-    
-    static std::string serializePlantState(PlantState* state);
-    static PlantState* deserializePlantState(const std::string& stateData);
+    static int plantTypeIndex(PlantTypeId type);   // -1 if it can't be stored
+    static Plant* createPlant(int typeIndex);
+    static PlantTypeId stackType(int typeIndex);   // NONE for -1
+    static uint8_t workerKindFromName(const char* type);
+    static Worker* createWorker(uint8_t kind);
+
+    static void writePlantTypes(BinaryWriter& out);
+    // remap[file type id] = PlantTypeId, or -1 for types this build doesn't know
+    static void readPlantTypes(BinaryReader& in, int* remap);
+    // Stage and resources only; the type is stored once per stack or plot
+    static void writePlant(BinaryWriter& out, Plant* plant);
+    static Plant* readPlant(BinaryReader& in, int typeIndex, int format);
+
+    static void clearGreenhouse(Greenhouse* greenhouse);
+    static void clearWorkers(std::vector<Worker*>& workers);
+
+    // Legacy "|"-delimited text
+    static Plant* deserializePlantText(const std::string& plantData);
+    static void deserializeInventoryText(Inventory* inventory, const std::string& data);
+    static void deserializeGreenhouseText(Greenhouse* greenhouse, const std::string& data);
+    static void deserializeWorkersText(std::vector<Worker*>& workers, const std::string& data);
     
     static std::vector<std::string> split(const std::string& str, char delimiter);
     static std::string join(const std::vector<std::string>& parts, char delimiter);
 };
 
-#endif
\ No newline at end of file
+#endif
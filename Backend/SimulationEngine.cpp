@@ -0,0 +1,134 @@
+#include "SimulationEngine.h"
+#include "Player.h"
+#include "Greenhouse.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <climits>
+
+const float SimulationEngine::SECONDS_PER_TICK = 0.5f;
+const int SimulationEngine::TICKS_PER_GAME_MINUTE = 2;
+const int SimulationEngine::MAX_TICKS_PER_UPDATE = 120;
+const int SimulationEngine::MORNING_HOUR = 6;
+const int SimulationEngine::NIGHT_HOUR = 20;
+
+SimulationEngine::SimulationEngine(Player* player)
+    : player(player), tickAccumulator(0.0f), tickCount(0), paused(false)
+{
+}
+
+void SimulationEngine::update(float dt)
+{
+    if (!player || paused || dt <= 0.0f)
+        return;
+
+    // Sample the speed before the clock moves so ticks and minutes agree on it
+    int timeScale = player->getTimeScale();
+
+    // A long frame is cut down before either the clock or the ticks see it,
+    // so both drop the same time and never drift apart
+    const float maxDt = MAX_TICKS_PER_UPDATE * SECONDS_PER_TICK / (float)timeScale;
+    dt = std::min(dt, maxDt);
+
+    player->UpdateGameTime(dt);
+    tickAccumulator += dt * (float)timeScale;
+
+    int ticksRun = 0;
+    while (tickAccumulator >= SECONDS_PER_TICK && ticksRun < MAX_TICKS_PER_UPDATE)
+    {
+        tickAccumulator -= SECONDS_PER_TICK;
+        step();
+        ticksRun++;
+    }
+}
+
+void SimulationEngine::step()
+{
+    if (!player)
+        return;
+
+    Greenhouse* greenhouse = player->getPlot();
+    if (greenhouse)
+    {
+        greenhouse->tickAllPlants();
+    }
+    tickCount++;
+}
+
+void SimulationEngine::runGameMinutes(long long minutes)
+{
+    if (!player)
+        return;
+
+    for (long long m = 0; m < minutes; m++)
+    {
+        player->advanceTime(1);
+        for (int t = 0; t < TICKS_PER_GAME_MINUTE; t++)
+        {
+            step();
+            // No real time passes between ticks here, so let the workers
+            // finish what this tick gave them before the next one
+            if (player->getWorkerCount() > 0)
+                WorkerPool::getInstance()->waitIdle();
+        }
+    }
+}
+
+void SimulationEngine::fastForward(long long minutes)
+{
+    if (!player || minutes <= 0)
+        return;
+
+    Greenhouse* greenhouse = player->getPlot();
+    const long long totalTicks = minutes * TICKS_PER_GAME_MINUTE;
+    long long ticksDone = 0;
+    long long minutesDone = 0;
+    while (ticksDone < totalTicks)
+    {
+        long long remaining = totalTicks - ticksDone;
+        long long ran = remaining;
+        if (greenhouse)
+            ran = greenhouse->tickUntilEvent((int)std::min<long long>(remaining, INT_MAX));
+        ticksDone += ran;
+        tickCount += ran;
+
+        // runGameMinutes moves the clock at the start of each minute, so a
+        // tick part way into a minute already sees that minute
+        const long long minutesDue = (ticksDone + TICKS_PER_GAME_MINUTE - 1) / TICKS_PER_GAME_MINUTE;
+        player->advanceTime((int)(minutesDue - minutesDone));
+        minutesDone = minutesDue;
+
+        if (player->getWorkerCount() > 0)
+            WorkerPool::getInstance()->waitIdle();
+    }
+}
+
+bool SimulationEngine::isNight() const
+{
+    return player && (player->getHour() >= NIGHT_HOUR || player->getHour() < MORNING_HOUR);
+}
+
+long long SimulationEngine::sleepUntilMorning()
+{
+    if (!isNight())
+        return 0;
+
+    const int minuteOfDay = player->getHour() * 60 + player->getMinute();
+    const long long minutes = (MORNING_HOUR * 60 - minuteOfDay + 24 * 60) % (24 * 60);
+    fastForward(minutes);
+    return minutes;
+}
+
+void SimulationEngine::setPaused(bool paused)
+{
+    this->paused = paused;
+}
+
+bool SimulationEngine::isPaused() const
+{
+    return paused;
+}
+
+long long SimulationEngine::getTickCount() const
+{
+    return tickCount;
+}
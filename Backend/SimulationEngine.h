@@ -0,0 +1,56 @@
+#pragma once
+
+class Player;
+
+// Fixed-timestep simulation clock.
+// Owns the game tick so the clock, greenhouse and workers keep advancing no
+// matter which scene is on screen (or whether there is a screen at all).
+class SimulationEngine
+{
+public:
+    SimulationEngine(Player* player);
+
+    // Real-time driver: advances the game clock by dt real seconds and runs
+    // every simulation tick that became due (scaled by the night/patrol speed).
+    void update(float dt);
+
+    // Runs exactly one simulation tick: all plants age, observers are notified.
+    void step();
+
+    // Headless driver: advances the clock by whole game minutes and runs the
+    // matching ticks back-to-back, without any real-time pacing. Waits for the
+    // worker pool after every tick so hired workers keep up.
+    void runGameMinutes(long long minutes);
+
+    // Leaves the clock and the greenhouse where runGameMinutes would (the
+    // plots are settled in closed form either way), but the ticks between
+    // plant events are skipped instead of run one by one; workers still get
+    // to react to each event tick before time moves on. For sleeping
+    // through the night and catching up on time spent away.
+    void fastForward(long long minutes);
+
+    // Between NIGHT_HOUR:00 and MORNING_HOUR:00, when the player can sleep
+    bool isNight() const;
+    // Fast-forwards to MORNING_HOUR:00 if it is night; returns the game
+    // minutes skipped (0 in the daytime). The menu's SLEEP button.
+    long long sleepUntilMorning();
+
+    void setPaused(bool paused);
+    bool isPaused() const;
+    long long getTickCount() const;
+
+    // Game-scaled seconds per simulation tick (two ticks per game minute).
+    static const float SECONDS_PER_TICK;
+    static const int TICKS_PER_GAME_MINUTE;
+    // Upper bound on catch-up ticks per frame so a long hitch can't stall the
+    // render loop; a longer frame is clamped to it, clock included.
+    static const int MAX_TICKS_PER_UPDATE;
+    static const int MORNING_HOUR;
+    static const int NIGHT_HOUR;
+
+private:
+    Player* player;
+    float tickAccumulator;
+    long long tickCount;
+    bool paused;
+};
@@ -0,0 +1,98 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+TimerWheel::TimerWheel(uint32_t now) : now(now)
+{
+}
+
+void TimerWheel::schedule(int id, uint32_t tick)
+{
+    place(Entry{id, tick > now ? tick : now + 1});
+}
+
+void TimerWheel::place(const Entry& entry)
+{
+    // The highest bits the tick doesn't share with now pick the level:
+    // it sits in the bucket the clock will reach first on that level
+    const uint32_t differs = entry.tick ^ now;
+    for (int level = 0; level < LEVELS; level++)
+    {
+        if ((differs >> (BITS * (level + 1))) == 0)
+        {
+            const uint32_t index = (entry.tick >> (BITS * level)) & (BUCKETS - 1);
+            buckets[level][index].push_back(entry);
+            occupied[level] |= 1ull << index;
+            return;
+        }
+    }
+    overflow.push_back(entry);
+}
+
+void TimerWheel::cascade(std::vector<Entry>& bucket)
+{
+    std::vector<Entry> moving;
+    moving.swap(bucket);
+    for (const Entry& entry : moving)
+        place(entry);
+}
+
+void TimerWheel::advance(std::vector<Entry>& due)
+{
+    now++;
+
+    // Refill the lower levels from the top down whenever the clock enters a
+    // new bucket of theirs, so entries for this tick reach level 0 in time
+    if ((now & ((1u << (BITS * LEVELS)) - 1)) == 0)
+        cascade(overflow);
+    for (int level = LEVELS - 1; level > 0; level--)
+    {
+        if ((now & ((1u << (BITS * level)) - 1)) == 0)
+        {
+            const uint32_t index = (now >> (BITS * level)) & (BUCKETS - 1);
+            occupied[level] &= ~(1ull << index);
+            cascade(buckets[level][index]);
+        }
+    }
+
+    const uint32_t index = now & (BUCKETS - 1);
+    std::vector<Entry>& current = buckets[0][index];
+    due.insert(due.end(), current.begin(), current.end());
+    current.clear();
+    occupied[0] &= ~(1ull << index);
+}
+
+void TimerWheel::advanceUntil(uint32_t last, std::vector<Entry>& due)
+{
+    const size_t before = due.size();
+    while (now < last && due.size() == before)
+    {
+        // Nothing happens on the ticks in between, cascades included, so the
+        // clock can be set just short of the next busy one
+        const uint32_t busy = std::min(nextBusyTick(), last);
+        if (busy > now + 1)
+            now = busy - 1;
+        advance(due);
+    }
+}
+
+uint32_t TimerWheel::nextBusyTick() const
+{
+    // Every entry on a level lies in a bucket after the clock's own within
+    // the current block of the level above (the clock's bucket was emptied
+    // on the way in), and lower levels hold earlier ticks. So the first
+    // occupied bucket on the lowest level that has one is where work is.
+    for (int level = 0; level < LEVELS; level++)
+    {
+        const int shift = BITS * level;
+        const uint32_t index = (now >> shift) & (BUCKETS - 1);
+        const uint64_t ahead = index == BUCKETS - 1 ? 0 : occupied[level] & (~0ull << (index + 1));
+        if (ahead != 0)
+        {
+            const uint32_t blockStart = now & ~((1u << (shift + BITS)) - 1);
+            return blockStart | ((uint32_t)__builtin_ctzll(ahead) << shift);
+        }
+    }
+    // Only the overflow is left; it comes in when the top level wraps
+    const uint32_t wrap = (now | ((1u << (BITS * LEVELS)) - 1)) + 1;
+    return wrap == 0 ? UINT32_MAX : wrap;
+}
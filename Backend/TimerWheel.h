@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timer wheel: ids scheduled to wake up on a given tick.
+// Level 0 has one bucket per tick for the next BUCKETS ticks; each level up
+// has buckets BUCKETS times wider, and a bucket's entries drop a level down
+// when the clock reaches it. Scheduling is O(1), and advancing the clock
+// costs one bucket plus the odd cascade, however many entries are waiting.
+// Entries beyond the top level wait in an overflow list that is sorted back
+// in each time the top level wraps. A bitmap per level marks the buckets
+// holding anything, so advanceUntil() can jump straight over idle ticks.
+//
+// Not thread safe; the owner locks around it.
+class TimerWheel
+{
+public:
+    struct Entry
+    {
+        int id;
+        uint32_t tick;
+    };
+
+    static constexpr int LEVELS = 4;
+    static constexpr int BITS = 6;
+    static constexpr int BUCKETS = 1 << BITS;
+
+    explicit TimerWheel(uint32_t now = 0);
+
+    uint32_t getNow() const { return now; }
+
+    // Wakes `id` at `tick`; a tick that isn't after now fires on the next advance()
+    void schedule(int id, uint32_t tick);
+
+    // Moves the clock on one tick and appends the entries due at the new tick
+    void advance(std::vector<Entry>& due);
+
+    // Moves the clock on until entries come due or it reaches `last`,
+    // whichever is first, and appends those entries. Stretches with nothing
+    // due are skipped in one go rather than a tick at a time.
+    void advanceUntil(uint32_t last, std::vector<Entry>& due);
+
+private:
+    uint32_t now;
+    std::vector<Entry> buckets[LEVELS][BUCKETS];
+    std::vector<Entry> overflow;
+    uint64_t occupied[LEVELS] = {};   // bit b: buckets[level][b] isn't empty
+
+    // Files an entry at or after now under the level its distance needs
+    void place(const Entry& entry);
+    void cascade(std::vector<Entry>& bucket);
+    // Earliest tick at which advance() finds entries or has some to cascade
+    uint32_t nextBusyTick() const;
+};
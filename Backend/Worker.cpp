@@ -4,18 +4,19 @@
 #include "Command.h"
 #include "Player.h"
 #include "Game.h"
+#include "WorkerPool.h"
+
+const int Worker::COMMANDS_PER_LEVEL = 4;
 
 Worker::Worker() : Observer()
 {
     subject = nullptr;
-    workerThread = std::thread(&Worker::executeCommand, this);
 }
 
 Worker::Worker(const Worker &worker)
 {
     this->level = worker.level;
     this->subject = worker.subject;
-    workerThread = std::thread(&Worker::executeCommand, this);
     // queue does not get copied over
 }
 
@@ -26,25 +27,39 @@ Worker::~Worker()
 
 void Worker::executeCommand()
 {
-    while(running){
-        std::unique_lock<std::mutex> lock(mtx);
-    
-        condition.wait(lock, [&]{return !commandQueue.empty() || !running;});
-        
-        if(!running){
-            break; 
+    int budget = level * COMMANDS_PER_LEVEL;
+    while (budget-- > 0)
+    {
+        Command *command = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!running || commandQueue.empty())
+                break;
+            command = commandQueue.front();
+            commandQueue.pop();
         }
-        Command *command = commandQueue.front();
-        commandQueue.pop();
 
-        lock.unlock(); 
         command->execute();
-        
+
         if(!command->isPatrol()){
             endPatrol();
         }
         delete command;
     }
+
+    // Requeue ourselves if there's more to do, otherwise leave the pool.
+    // Nothing may touch this worker after scheduled goes false: stop() may
+    // be waiting to delete it.
+    std::lock_guard<std::mutex> lock(mtx);
+    if (running && !commandQueue.empty())
+    {
+        WorkerPool::getInstance()->submit(this, level);
+    }
+    else
+    {
+        scheduled = false;
+        condition.notify_all();
+    }
 }
 
 void Worker::clearCommandQueue()
@@ -60,13 +75,21 @@ void Worker::clearCommandQueue()
         }
     }
 }
+
 void Worker::addCommand(Command *command)
 {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!running)
+    {
+        delete command;
+        return;
+    }
+    commandQueue.push(command);
+    if (!scheduled)
     {
-        std::lock_guard<std::mutex> lock(mtx);
-        commandQueue.push(command);
+        scheduled = true;
+        WorkerPool::getInstance()->submit(this, level);
     }
-    condition.notify_one();
 }
 
 void Worker::setSubject(Greenhouse *greenhouse)
@@ -76,15 +99,19 @@ void Worker::setSubject(Greenhouse *greenhouse)
 
 void Worker::stop()
 {
-    if (running)
-    {
-        running = false;
-        condition.notify_all();
-        if (workerThread.joinable())
-        {
-            workerThread.join();
-        }
-    }
+    running = false;
+    clearCommandQueue();
+
+    std::unique_lock<std::mutex> lock(mtx);
+    condition.wait(lock, [this] { return !scheduled; });
+}
+
+void Worker::start()
+{
+    running = true;
+    // Anything dropped while stopped would never cross its threshold again
+    if (subject)
+        subject->resync(this);
 }
 
 void Worker::startPatrol()
@@ -108,83 +135,60 @@ void Worker::setLevel(int level)
         this->level = level;
     }
 }
+int Worker::getLevel() const
+{
+    return level;
+}
+
 void Worker::update()
 {
+    // Work arrives as PlotEvents; a plain notify() has nothing new for us
     return;
 }
 
-// void WaterWorker::update()
-// {
-//     if(subject){
-//         for(int i = 0; i < subject->getCapacity(); i++){
-//             Plant* plant = subject->getPlant(i);
-//             if(plant && plant->getWater() <= 20.0f){
-//                 addCommand(new WaterCommand(plant, subject));
-//             }
-//         }
-//     }
-// }
-
-void WaterWorker::update()
+void Worker::onPlotEvents(const std::vector<PlotEvent> &events)
 {
-    if (subject)
-    {
-        clearCommandQueue();
+    if (!subject)
+        return;
 
-        for (int i = 0; i < subject->getCapacity(); i++)
+    for (const PlotEvent &event : events)
+    {
+        Command *command = commandFor(event);
+        if (command)
         {
-            Plant *plant = subject->getPlant(i);
-            if (plant && plant->getWater() <= 20.0f)
-            {
-                addCommand(new WaterCommand(plant, subject));
-            }
+            addCommand(command);
         }
     }
 }
 
-void FertiliserWorker::update()
+Command *Worker::commandFor(const PlotEvent &)
 {
-    if (subject)
-    {
-        clearCommandQueue();
-        for (int i = 0; i < subject->getCapacity(); i++)
-        {
-            Plant *plant = subject->getPlant(i);
+    return nullptr;
+}
 
-            if (plant && plant->getNutrients() <= 20.0f)
-            {
-                addCommand(new FertilizeCommand(plant, subject)); // Pass subject for crash guard
-            }
-        }
+Command *WaterWorker::commandFor(const PlotEvent &event)
+{
+    if (event.type == PlotEventType::NeedsWater)
+    {
+        return new WaterCommand(event.plot, subject);
     }
+    return nullptr;
 }
 
-// void HarvestWorker::update()
-// {
-//     if(subject){
-//         for(int i = 0; i < subject->getCapacity(); i++){
-//             Plant* plant = subject->getPlant(i);
-//             if(plant && plant->isRipe()){
-//                 addCommand(new HarvestCommand(plant,subject));
-//             }
-//         }
-//     }
-// }
-
-void HarvestWorker::update()
+Command *FertiliserWorker::commandFor(const PlotEvent &event)
 {
-    if (subject)
+    if (event.type == PlotEventType::NeedsNutrients)
     {
- clearCommandQueue();
-        for (int i = 0; i < subject->getCapacity(); i++)
-        {
-            Plant *plant = subject->getPlant(i);
+        return new FertilizeCommand(event.plot, subject);
+    }
+    return nullptr;
+}
 
-            // Recheck status and queue fresh commands
-            if (plant && plant->isRipe())
-            {
-                addCommand(new HarvestCommand(plant, subject)); // Pass subject for crash guard
-            }
-        }
+Command *HarvestWorker::commandFor(const PlotEvent &event)
+{
+    if (event.type == PlotEventType::Ripe)
+    {
+        return new HarvestCommand(event.plot, subject);
     }
+    return nullptr;
 }
@@ -5,7 +5,6 @@
 #include "Plant.h"
 #include "PlantState.h"
 #include <mutex>
-#include <thread>
 #include <chrono>
 #include <condition_variable>
 #include <atomic>
@@ -14,6 +13,8 @@
 // Forward declaration
 class Greenhouse;
 
+// A hired worker is a logical agent: it queues its commands and hands itself
+// to the shared WorkerPool, which runs them in order a batch at a time.
 class Worker : public Observer
 {
 
@@ -23,41 +24,52 @@ public:
     virtual ~Worker();
 
     void setLevel(int level);
+    int getLevel() const;
+    // Runs the next batch of queued commands (called by the WorkerPool)
     void executeCommand();
     void addCommand(Command *command);
     void setSubject(Greenhouse* greenhouse) override;
     void update() override;
+    // Queues a command for each event this kind of worker handles
+    void onPlotEvents(const std::vector<PlotEvent>& events) override;
+    // stop() drops queued commands and waits for a running batch to finish
     void stop();
+    void start();
     virtual const char *type() const { return "Manager/Generic Worker"; }
     void clearCommandQueue();
 protected:
     void startPatrol();
     void endPatrol();
+    // The command this worker runs for an event, or nullptr to ignore it
+    virtual Command* commandFor(const PlotEvent& event);
     std::string currentTaskDescription;
     std::mutex mtx;
     std::condition_variable condition;
     std::atomic<bool> running{true};
-    std::thread workerThread;
+    bool scheduled = false; // queued or running in the pool (guarded by mtx)
     std::queue<Command *> commandQueue;
     // not responsible for  memory
     Greenhouse *subject;
     int level = 1;
+
+    // Commands per batch for each skill level before yielding the pool thread
+    static const int COMMANDS_PER_LEVEL;
 };
 
 class WaterWorker : public Worker
 {
-    void update() override;
+    Command* commandFor(const PlotEvent& event) override;
     const char *type() const override { return "Water Worker"; }
 };
 
 class FertiliserWorker : public Worker
 {
-    void update() override;
+    Command* commandFor(const PlotEvent& event) override;
     const char *type() const override { return "Fertiliser Worker"; }
 };
 
 class HarvestWorker : public Worker
 {
-    void update() override;
+    Command* commandFor(const PlotEvent& event) override;
     const char *type() const override { return "Harvest Worker"; }
 };
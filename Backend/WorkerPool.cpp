@@ -0,0 +1,195 @@
+#include "WorkerPool.h"
+#include "Worker.h"
+#include <cstdlib>
+
+WorkerPool* WorkerPool::instance = nullptr;
+std::mutex WorkerPool::instanceMutex;
+int WorkerPool::requestedThreads = 0;
+
+// Lane of the pool thread we're running on, -1 for any other thread
+static thread_local int currentLane = -1;
+
+WorkerPool::WorkerPool(int threadCount)
+    : nextLane(0), queued(0), pending(0), sleeping(0), stopping(false)
+{
+    for (int i = 0; i < threadCount; i++)
+    {
+        lanes.push_back(new Lane());
+    }
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back(&WorkerPool::run, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+    for (Lane* lane : lanes)
+    {
+        delete lane;
+    }
+}
+
+WorkerPool* WorkerPool::getInstance()
+{
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (instance == nullptr)
+    {
+        static bool registered = false;
+        if (!registered)
+        {
+            std::atexit(WorkerPool::shutdown);
+            registered = true;
+        }
+        int threads = requestedThreads;
+        if (threads <= 0)
+            threads = (int)std::thread::hardware_concurrency();
+        instance = new WorkerPool(threads > 0 ? threads : 2);
+    }
+    return instance;
+}
+
+void WorkerPool::shutdown()
+{
+    WorkerPool* pool;
+    {
+        std::lock_guard<std::mutex> lock(instanceMutex);
+        pool = instance;
+        instance = nullptr;
+    }
+    delete pool;
+}
+
+void WorkerPool::setThreadCount(int threads)
+{
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    requestedThreads = threads;
+}
+
+void WorkerPool::submit(Worker* worker, int priority)
+{
+    if (!worker)
+        return;
+
+    if (priority < 1)
+        priority = 1;
+    if (priority > PRIORITY_LEVELS)
+        priority = PRIORITY_LEVELS;
+
+    // Batches queued from a pool thread stay on its lane (warm cache),
+    // everything else is spread round-robin
+    int laneIndex = currentLane >= 0 ? currentLane : (int)(nextLane++ % lanes.size());
+    Lane* lane = lanes[laneIndex];
+
+    // Count first so waitIdle() can never see zero while this batch is in flight
+    pending++;
+    {
+        std::lock_guard<std::mutex> lock(lane->mtx);
+        lane->queues[priority - 1].push_back(worker);
+        queued++;
+    }
+
+    // A thread about to sleep bumps `sleeping` before it checks `queued`, and
+    // we bump `queued` before reading `sleeping`, so one of us sees the
+    // other. Taking the lock means it is really waiting before we notify.
+    if (sleeping.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_one();
+    }
+}
+
+void WorkerPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idle.wait(lock, [this] { return pending.load() == 0; });
+}
+
+int WorkerPool::getThreadCount() const
+{
+    return (int)threads.size();
+}
+
+Worker* WorkerPool::takeOwn(int laneIndex)
+{
+    Lane* lane = lanes[laneIndex];
+    std::lock_guard<std::mutex> lock(lane->mtx);
+    for (int p = PRIORITY_LEVELS - 1; p >= 0; p--)
+    {
+        if (!lane->queues[p].empty())
+        {
+            Worker* worker = lane->queues[p].front();
+            lane->queues[p].pop_front();
+            queued--;
+            return worker;
+        }
+    }
+    return nullptr;
+}
+
+Worker* WorkerPool::steal(int laneIndex)
+{
+    int count = (int)lanes.size();
+    for (int offset = 1; offset < count; offset++)
+    {
+        Lane* lane = lanes[(laneIndex + offset) % count];
+        std::lock_guard<std::mutex> lock(lane->mtx);
+        for (int p = PRIORITY_LEVELS - 1; p >= 0; p--)
+        {
+            if (!lane->queues[p].empty())
+            {
+                Worker* worker = lane->queues[p].back();
+                lane->queues[p].pop_back();
+                queued--;
+                return worker;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void WorkerPool::run(int laneIndex)
+{
+    currentLane = laneIndex;
+
+    while (true)
+    {
+        Worker* worker = takeOwn(laneIndex);
+        if (!worker)
+            worker = steal(laneIndex);
+        if (!worker)
+        {
+            // Nothing left in any lane (or another thread just took it): the
+            // count is only dropped with a take, so a miss goes back to sleep
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleeping++;
+            wake.wait(lock, [this] { return queued.load() > 0 || stopping; });
+            sleeping--;
+            if (queued.load() == 0 && stopping)
+                break;
+            continue;
+        }
+
+        worker->executeCommand();
+
+        if (--pending == 0)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            idle.notify_all();
+        }
+    }
+
+    currentLane = -1;
+}
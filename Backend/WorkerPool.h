@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Worker;
+
+// Shared executor for every hired Worker.
+// A fixed set of threads (one per core) runs worker batches instead of each
+// Worker owning an OS thread. Each thread has its own lane of run queues and
+// idle threads steal from the back of other lanes. A Worker is queued at most
+// once at a time, so its commands still run one after another in order.
+// Skill level is the priority: level 3 workers are picked before level 1.
+class WorkerPool
+{
+public:
+    static WorkerPool* getInstance();
+    // Finishes everything queued, joins the threads and frees the pool
+    static void shutdown();
+    // Thread count for the next pool created (0 = one per core). Call before
+    // first use, or after shutdown(); the stress test uses it to oversubscribe.
+    static void setThreadCount(int threads);
+
+    // Queue a batch for this worker (the worker guarantees one at a time)
+    void submit(Worker* worker, int priority);
+
+    // Blocks until no batch is queued or running, including any work those
+    // batches queue in turn. Used by the headless driver to keep workers in
+    // lock-step with the simulation. Must not be called from a pool thread.
+    void waitIdle();
+
+    int getThreadCount() const;
+
+    static const int PRIORITY_LEVELS = 3;
+
+private:
+    WorkerPool(int threadCount);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    struct Lane
+    {
+        std::mutex mtx;
+        std::deque<Worker*> queues[PRIORITY_LEVELS]; // index = priority - 1
+    };
+
+    void run(int laneIndex);
+    Worker* takeOwn(int laneIndex);
+    Worker* steal(int laneIndex);
+
+    static WorkerPool* instance;
+    static std::mutex instanceMutex;
+    static int requestedThreads;
+
+    std::vector<Lane*> lanes;
+    std::vector<std::thread> threads;
+    std::atomic<unsigned int> nextLane;
+
+    // Only sleeping and waking go through sleepMutex; the counts are atomic
+    // so submitting, taking and finishing a batch never touch it otherwise
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::atomic<int> queued;    // batches in lanes; changed under the lane's lock with the push/take
+    std::atomic<int> pending;   // batches queued or running
+    std::atomic<int> sleeping;  // pool threads waiting on wake
+    bool stopping;              // guarded by sleepMutex
+};
@@ -0,0 +1,195 @@
+// Greenhouse concurrency stress driver.
+// Many workers water, fertilise and harvest on the shared WorkerPool while the
+// main thread ticks, replants, clears plots, reads plant state and sells from
+// the inventory the harvests land in, the way the game loop and UI do. The greenhouse also keeps growing a chunk at a time while
+// the workers are busy. Built with ThreadSanitizer by `make stress`; any report from
+// TSan or a broken invariant below is a bug.
+//
+// Usage: ./greenhouse_stress [ticks] [workers] [pool threads]
+
+#include "Game.h"
+#include "Greenhouse.h"
+#include "Inventory.h"
+#include "PlantFactory.h"
+#include "Worker.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    int workerCount = (argc > 2) ? std::atoi(argv[2]) : 48;
+    if (ticks <= 0)
+        ticks = 20000;
+    if (workerCount <= 0)
+        workerCount = 48;
+
+    // At least 8 pool threads even on small machines, so workers really overlap
+    int threads = (argc > 3) ? std::atoi(argv[3]) : 0;
+    if (threads <= 0)
+        threads = std::max(8, (int)std::thread::hardware_concurrency());
+    WorkerPool::setThreadCount(threads);
+
+    // Commands reach the Game singleton (patrol flag); create it up front
+    Game::getInstance();
+
+    Inventory *inventory = new Inventory(1000000);
+    Greenhouse *greenhouse = new Greenhouse(inventory);
+    greenhouse->increaseCapacity(128 - greenhouse->getCapacity());
+    const int finalCapacity = 512;
+
+    std::vector<Worker *> workers;
+    for (int i = 0; i < workerCount; i++)
+    {
+        Worker *worker;
+        switch (i % 3)
+        {
+        case 0:
+            worker = new WaterWorker();
+            break;
+        case 1:
+            worker = new FertiliserWorker();
+            break;
+        default:
+            worker = new HarvestWorker();
+            break;
+        }
+        worker->setLevel(1 + i % 3);
+        greenhouse->attach(worker);
+        workers.push_back(worker);
+    }
+
+    RandomPlantFactory factory;
+    long long planted = 0;
+    long long removed = 0;
+    long long sold = 0;
+    unsigned int seed = 12345;
+
+    for (int tick = 0; tick < ticks; tick++)
+    {
+        greenhouse->tickAllPlants();
+
+        if (tick % 1000 == 999 && greenhouse->getCapacity() < finalCapacity)
+        {
+            greenhouse->increaseCapacity(Greenhouse::PLOTS_PER_CHUNK);
+        }
+
+        // Replant whatever the harvesters cleared
+        if (tick % 4 == 0)
+        {
+            while (greenhouse->getSize() < greenhouse->getCapacity())
+            {
+                Plant *plant = factory.produce();
+                if (!greenhouse->addPlant(plant))
+                {
+                    delete plant;
+                    break;
+                }
+                planted++;
+            }
+        }
+
+        seed = seed * 1103515245u + 12345u;
+        int plot = (int)((seed >> 8) % (unsigned int)greenhouse->getCapacity());
+
+        // Reads from the "UI" thread while workers are busy: the inspector's
+        // snapshot, the draw loop's locked access and the inventory screen
+        PlotHandle handle = greenhouse->getHandle(plot);
+        PlotSnapshot inspected = greenhouse->inspect(handle);
+        if (!inspected.isEmpty() && inspected.getType().empty())
+        {
+            std::cout << "FAIL: snapshot of plot " << plot << " has no type" << std::endl;
+            return 1;
+        }
+        greenhouse->withPlant(handle, [](Plant *plant) {
+            volatile float water = plant->getWater();
+            (void)water;
+        });
+        const std::string &crop = PlantTypes::name((PlantTypeId)(seed % PlantTypes::BUILT_IN_COUNT));
+        volatile int stock = inventory->getPlantCount(crop);
+        (void)stock;
+        InventorySlot shown = inventory->getSlot((seed >> 4) % 64);
+        if (shown.getSize() > InventorySlot::capacity)
+        {
+            std::cout << "FAIL: torn inventory slot" << std::endl;
+            return 1;
+        }
+
+        // Sell while harvests are still landing, like the store scene
+        if (tick % 8 == 0)
+        {
+            Plant *produce = inventory->removeItem(crop);
+            if (produce)
+            {
+                delete produce;
+                sold++;
+            }
+        }
+
+        if (tick % 16 == 0 && greenhouse->removePlant(plot))
+        {
+            removed++;
+        }
+    }
+
+    WorkerPool::getInstance()->waitIdle();
+
+    int stillPlanted = 0;
+    for (int i = 0; i < greenhouse->getCapacity(); i++)
+    {
+        if (greenhouse->getPlant(i))
+            stillPlanted++;
+    }
+
+    long long harvested = sold;
+    long long counted = 0;
+    for (size_t i = 0; i < inventory->getStackCount(); i++)
+    {
+        harvested += inventory->getSlot(i).getSize();
+    }
+    for (int type = 0; type < PlantTypes::count(); type++)
+    {
+        counted += inventory->getPlantCount(PlantTypes::name((PlantTypeId)type));
+    }
+
+    std::cout << "=== Greenhouse stress ===" << std::endl;
+    std::cout << "Ticks: " << ticks << ", workers: " << workerCount
+              << ", pool threads: " << WorkerPool::getInstance()->getThreadCount() << std::endl;
+    std::cout << "Plots: " << greenhouse->getCapacity() << std::endl;
+    std::cout << "Planted " << planted << ", harvested " << harvested
+              << ", removed " << removed << ", still planted " << stillPlanted << std::endl;
+    std::cout << "Sold " << sold << " while harvesting" << std::endl;
+
+    bool ok = true;
+    if (stillPlanted != greenhouse->getSize())
+    {
+        std::cout << "FAIL: size " << greenhouse->getSize() << " but " << stillPlanted << " plots occupied" << std::endl;
+        ok = false;
+    }
+    if (counted != harvested - sold)
+    {
+        std::cout << "FAIL: inventory counts " << counted << " but stacks hold " << harvested - sold << std::endl;
+        ok = false;
+    }
+    // The greenhouse starts empty, so every plant must be accounted for exactly once
+    if (planted != harvested + removed + stillPlanted)
+    {
+        std::cout << "FAIL: plants lost or harvested twice" << std::endl;
+        ok = false;
+    }
+
+    for (Worker *worker : workers)
+    {
+        greenhouse->detach(worker);
+        delete worker;
+    }
+    delete greenhouse;
+    delete inventory;
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
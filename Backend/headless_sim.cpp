@@ -0,0 +1,75 @@
+// Headless simulation driver.
+// Runs the Backend without raylib: fills the greenhouse, hires one worker of
+// each kind and fast-forwards the SimulationEngine for a number of game days.
+// Used for balancing runs and regression checks on machines without a display.
+//
+// Usage: ./sim_headless [days]
+
+#include "Command.h"
+#include "Game.h"
+#include "PlantFactory.h"
+#include "SimulationEngine.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    int days = (argc > 1) ? std::atoi(argv[1]) : 30;
+    if (days <= 0)
+        days = 30;
+
+    Game *game = Game::getInstance();
+    Player *player = game->getPlayerPtr();
+    Greenhouse *greenhouse = player->getPlot();
+
+    RandomPlantFactory factory;
+    while (greenhouse->getSize() < greenhouse->getCapacity())
+    {
+        greenhouse->addPlant(factory.produce());
+    }
+
+    player->addWorker(new WaterWorker());
+    player->addWorker(new FertiliserWorker());
+    player->addWorker(new HarvestWorker());
+
+    SimulationEngine &simulation = game->getSimulation();
+
+    auto start = std::chrono::steady_clock::now();
+    simulation.runGameMinutes((long long)days * 24 * 60);
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    int alive = 0, ripe = 0, dead = 0;
+    for (int i = 0; i < greenhouse->getCapacity(); i++)
+    {
+        // Workers may still be finishing commands, so read through the lock
+        const PlotSnapshot plant = greenhouse->inspect(greenhouse->getHandle(i));
+        if (plant.isEmpty())
+            continue;
+        if (plant.isDead())
+            dead++;
+        else if (plant.isRipe())
+            ripe++;
+        else
+            alive++;
+    }
+
+    std::cout << "=== Headless simulation ===" << std::endl;
+    std::cout << "Days simulated: " << days << " (now day " << player->getDay() << ", " << player->getTimeString() << ")" << std::endl;
+    std::cout << "Ticks: " << simulation.getTickCount() << std::endl;
+    std::cout << "Wall time: " << seconds << " s (" << (seconds > 0.0 ? days / seconds : 0.0) << " days/s)" << std::endl;
+    std::cout << "Plots: " << greenhouse->getSize() << "/" << greenhouse->getCapacity()
+              << " growing " << alive << ", ripe " << ripe << ", dead " << dead << std::endl;
+    std::cout << "Inventory stacks: " << player->getInventory()->getStackCount() << std::endl;
+
+    // heap = times a pool had to grow; flat once the simulation is warm
+    PoolStats commands = Command::poolStats();
+    PoolStats plants = Plant::poolStats();
+    std::cout << "Commands made: " << commands.allocations << " (heap " << commands.heapAllocations << ")"
+              << ", plants made: " << plants.allocations << " (heap " << plants.heapAllocations << ")" << std::endl;
+
+    Game::cleanup();
+    return 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "raylib.h"
+
+// The part of a scene that doesn't move (ground tiles, roads, buildings),
+// drawn once into a render texture and then put on screen as one quad per
+// frame. Scenes rebuild it when whatever it was drawn from changes.
+// Meant for the bottom layer: the texture is made fully opaque.
+class CachedLayer
+{
+public:
+    CachedLayer() : target(), valid(false) {}
+    ~CachedLayer() { unload(); }
+
+    CachedLayer(const CachedLayer&) = delete;
+    CachedLayer& operator=(const CachedLayer&) = delete;
+
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; }
+
+    // Redraws the layer with drawContents() (screen coordinates)
+    template <typename DrawFn>
+    void rebuild(int width, int height, DrawFn drawContents)
+    {
+        if (target.id == 0 || target.texture.width != width || target.texture.height != height)
+        {
+            unload();
+            target = LoadRenderTexture(width, height);
+        }
+        valid = false;
+        if (target.id == 0)
+            return;
+
+        BeginTextureMode(target);
+        ClearBackground(BLANK);
+        drawContents();
+        // Shadows and other see-through shapes leave the texture's alpha
+        // below 255, which would let the clear colour show through later.
+        // Additive black raises alpha without touching the colours.
+        BeginBlendMode(BLEND_ADDITIVE);
+        DrawRectangle(0, 0, width, height, Color{0, 0, 0, 255});
+        EndBlendMode();
+        EndTextureMode();
+        valid = true;
+    }
+
+    // Puts the layer on screen; if it couldn't be built, draws the
+    // contents directly instead
+    template <typename DrawFn>
+    void draw(DrawFn drawContents) const
+    {
+        draw(Vector2{0.0f, 0.0f}, drawContents);
+    }
+
+    // Same, with the layer's top-left corner at `position`. Lets one layer
+    // stand in for many identical tiles; the fallback has to do its own
+    // offsetting.
+    template <typename DrawFn>
+    void draw(Vector2 position, DrawFn drawContents) const
+    {
+        if (!valid)
+        {
+            drawContents();
+            return;
+        }
+        // Render textures are stored bottom-up
+        Rectangle source = {0.0f, 0.0f, (float)target.texture.width, -(float)target.texture.height};
+        DrawTextureRec(target.texture, source, position, WHITE);
+    }
+
+    void unload()
+    {
+        // After CloseWindow() there is no context left to free it in
+        if (target.id != 0 && IsWindowReady())
+        {
+            UnloadRenderTexture(target);
+        }
+        target = RenderTexture2D();
+        valid = false;
+    }
+
+private:
+    RenderTexture2D target;
+    bool valid;
+};
@@ -2,6 +2,7 @@
 #include "OutdoorScene.h" 
 #include "../Backend/PlantFactory.h"
 #include "CustomerFlyweight.h"
+#include "PlantSpriteCache.h"
 #include "InventoryUI.h"
 #include <stdlib.h>
 #include <time.h>
@@ -74,7 +75,8 @@ void Demo::run() {
         float dt = GetFrameTime();
         
         // Time Update: Managed by Player
-        Game::getInstance()->getPlayer().UpdateGameTime(dt); 
+        Game::getInstance()->getSimulation().update(dt); 
+        Game::getInstance()->autosaveIfDue();
         
         // Scene Management
         manager.Update(dt);
@@ -87,5 +89,6 @@ void Demo::run() {
     }
     
     // 3. Cleanup
+    PlantSpriteCache::getInstance().cleanup();
     CloseWindow();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "GreenHouseScene.h"
 #include <math.h>
 #include <stdlib.h>
+#include <algorithm>
 
 // --- INSPECTOR BAR CONSTANTS (NEW HORIZONTAL LAYOUT) ---
 
@@ -12,37 +13,19 @@ const float INSPECTOR_BAR_WIDTH = MENU_X_START + 10;                     // Bar
 const float BUTTON_PADDING = 10.0f;                                      // Increased padding for clarity
 
 // --- GRID CONSTANTS ---
-const int GRID_START_X = 50;
-const int GRID_START_Y = 50;
-const int PLOT_SIZE = 90;
-const int PATH_SIZE = 50;
-const int NARROW_PATH_WIDTH = 30;
-const int MIDDLE_PATH_INDEX = 7;
-const float REAL_SECONDS_PER_GAME_TICK = 0.5f;
-
-// --- Plant Catalog (Hardcoded, assumed Factory/Visual Strategies exist) ---
-#include <memory>
-
-// Helper function to create the catalog
-std::map<std::string, std::tuple<float, std::unique_ptr<PlantFactory>, std::unique_ptr<PlantVisualStrategy>>> createPlantCatalog() {
-    std::map<std::string, std::tuple<float, std::unique_ptr<PlantFactory>, std::unique_ptr<PlantVisualStrategy>>> catalog;
-    
-    catalog.emplace("Lettuce", std::make_tuple(15.0f, std::make_unique<LettuceFactory>(), std::make_unique<LettuceVisualStrategy>(20.0f, 15.0f)));
-    catalog.emplace("Carrot", std::make_tuple(25.0f, std::make_unique<CarrotFactory>(), std::make_unique<CarrotVisualStrategy>(15.0f, 30.0f)));
-    catalog.emplace("Potato", std::make_tuple(35.0f, std::make_unique<PotatoFactory>(), std::make_unique<PotatoVisualStrategy>(18.0f, 20.0f)));
-    catalog.emplace("Cucumber", std::make_tuple(45.0f, std::make_unique<CucumberFactory>(), std::make_unique<CucumberVisualStrategy>(20.0f, 35.0f)));
-    catalog.emplace("Tomato", std::make_tuple(55.0f, std::make_unique<TomatoFactory>(), std::make_unique<TomatoVisualStrategy>(25.0f, 25.0f)));
-    catalog.emplace("Pepper", std::make_tuple(65.0f, std::make_unique<PepperFactory>(), std::make_unique<PepperVisualStrategy>(25.0f, 30.0f)));
-    catalog.emplace("Sunflower", std::make_tuple(80.0f, std::make_unique<SunflowerFactory>(), std::make_unique<SunflowerVisualStrategy>(25.0f, 50.0f)));
-    catalog.emplace("Strawberry", std::make_tuple(100.0f, std::make_unique<StrawberryFactory>(), std::make_unique<StrawberryVisualStrategy>(25.0f, 15.0f)));
-    catalog.emplace("Corn", std::make_tuple(120.0f, std::make_unique<CornFactory>(), std::make_unique<CornVisualStrategy>(20.0f, 55.0f)));
-    catalog.emplace("Pumpkin", std::make_tuple(200.0f, std::make_unique<PumpkinFactory>(), std::make_unique<PumpkinVisualStrategy>(40.0f, 30.0f)));
-    
-    return catalog;
-}
-
-// Initialize the global variable
-std::map<std::string, std::tuple<float, std::unique_ptr<PlantFactory>, std::unique_ptr<PlantVisualStrategy>>> plantCatalog = createPlantCatalog();
+// Grid geometry lives in GreenhouseLayout
+const int PLOT_SIZE = GreenhouseLayout::PLOT_SIZE;
+
+// --- CAMERA CONSTANTS ---
+const Rectangle GRID_VIEW = {0.0f, 0.0f, (float)(MENU_X_START), (float)SCREEN_HEIGHT}; // Screen area the plots show in
+const float MIN_ZOOM = 0.1f;      // Whole 4096-plot greenhouse on screen
+const float MAX_ZOOM = 3.0f;
+const float ZOOM_STEP = 0.1f;     // Per mouse wheel notch
+const float PAN_SPEED = 600.0f;   // Screen pixels per second with the arrow keys
+// Level of detail by zoom: full strategy drawing up close, atlas sprites
+// in between, flat coloured tiles when plants are only a few pixels big
+const float DETAIL_ZOOM = 1.5f;
+const float SPRITE_ZOOM = 0.4f;
 
 std::map<std::string, WorkerData> workerCatalog = {
     {"Water Worker", {"Water", 200.0f, BLUE}},            // Blue for Water
@@ -76,13 +59,19 @@ Worker *CreateSpecializedWorker(const std::string &type)
 
 // --- CONSTRUCTOR AND INIT ---
 GreenHouseScene::GreenHouseScene()
-    : numPlants(0), numPaths(0), nextScene(SCENE_GREENHOUSE), isShopOpen(false), isHireShopOpen(false), selectedPlotIndex(-1), simTimeAccumulator(0.0f) {}
+    : numPlants(0), numPaths(0), nextScene(SCENE_GREENHOUSE), isShopOpen(false), isHireShopOpen(false), selectedPlot(),
+      layout(), camera{{0.0f, 0.0f}, {0.0f, 0.0f}, 0.0f, 1.0f} {}
 
 void GreenHouseScene::Init()
 {
     nextScene = GetSceneType();
     InitPlants();
     InitPaths();
+    layout.update(Game::getInstance()->getPlayerPtr()->getPlot()->getCapacity());
+    if (!groundLayer.isValid())
+    {
+        groundLayer.rebuild(GreenhouseLayout::CHUNK_WIDTH, GreenhouseLayout::CHUNK_HEIGHT, [this]() { DrawGround(Vector2{0.0f, 0.0f}); });
+    }
 }
 
 void GreenHouseScene::InitPlants()
@@ -100,15 +89,15 @@ void GreenHouseScene::InitPaths()
 // --- UPDATE AND CHECKEXIT ---
 void GreenHouseScene::Update(float dt)
 {
-    // Accumulate real-time elapsed since last simulation tick
-    simTimeAccumulator += dt;
+    // Plants are ticked by the SimulationEngine, not by this scene, so they keep
+    // growing while the player is elsewhere.
 
-    if (simTimeAccumulator >= REAL_SECONDS_PER_GAME_TICK)
+    // Workers can harvest or clear the selected plot behind our back; drop the
+    // selection instead of inspecting whatever ends up in that plot next
+    Player *player = Game::getInstance()->getPlayerPtr();
+    if (player && !selectedPlot.isNull() && !player->getPlot()->isCurrent(selectedPlot))
     {
-        simTimeAccumulator -= REAL_SECONDS_PER_GAME_TICK;
-
-        Greenhouse *gh = Game::getInstance()->getPlayerPtr()->getPlot();
-        gh->tickAllPlants();
+        selectedPlot = PlotHandle();
     }
 }
 
@@ -124,6 +113,8 @@ void GreenHouseScene::HandleInput()
         return;
     }
 
+    HandleCameraInput();
+
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
     {
         Vector2 mousePos = GetMousePosition();
@@ -144,13 +135,14 @@ void GreenHouseScene::HandleInput()
             return;
         }
 
-        if (selectedPlotIndex != -1)
+        if (!selectedPlot.isNull())
         {
             Greenhouse *gh = Game::getInstance()->getPlayerPtr()->getPlot();
-            Plant *plant = gh->getPlant(selectedPlotIndex);
+            // A copy: a worker may harvest the plant while we decide
+            const PlotSnapshot plant = gh->inspect(selectedPlot);
 
             // Only proceed if a plant is actually in the selected plot
-            if (plant)
+            if (!plant.isEmpty())
             {
                 // Constants used for inspector button hitboxes (matching DrawPlantInspector)
                 const float boxWidth = MENU_WIDTH - 10;
@@ -176,8 +168,8 @@ void GreenHouseScene::HandleInput()
                 // a. Water Button (R1, C1)
                 if (CheckCollisionPointRec(mousePos, btnWater))
                 {
-                    if (Game::getInstance()->getPlayerPtr()->getMoney() >= 0.5f) {
-                        plant->water(10.0f);
+                    if (Game::getInstance()->getPlayerPtr()->getMoney() >= 0.5f &&
+                        gh->withPlant(selectedPlot, [](Plant *p) { p->water(10.0f); })) {
                         Game::getInstance()->getPlayerPtr()->subtractMoney(0.5f);
                     }
                     return;
@@ -185,8 +177,8 @@ void GreenHouseScene::HandleInput()
                 // b. Fertilize Button (R1, C2)
                 else if (CheckCollisionPointRec(mousePos, btnFert))
                 {
-                    if (Game::getInstance()->getPlayerPtr()->getMoney() >= 1.0f) {
-                        plant->fertilize(5.0f);
+                    if (Game::getInstance()->getPlayerPtr()->getMoney() >= 1.0f &&
+                        gh->withPlant(selectedPlot, [](Plant *p) { p->fertilize(5.0f); })) {
                         Game::getInstance()->getPlayerPtr()->subtractMoney(1.0f);
                     }
                     return;
@@ -194,79 +186,41 @@ void GreenHouseScene::HandleInput()
                 // c. DELETE Button (R2, C2)
                 else if (CheckCollisionPointRec(mousePos, btnDelete))
                 {
-                    gh->removePlant(selectedPlotIndex);
-                    selectedPlotIndex = -1;
+                    gh->removePlant(selectedPlot.index);
+                    selectedPlot = PlotHandle();
                     return;
                 }
                 // d. Harvest/Deroot/Growing Action Button (R2, C1)
                 else if (CheckCollisionPointRec(mousePos, btnAction))
                 {
-                    if (plant->isRipe())
+                    if (plant.isRipe())
                     {
                         std::cout << "BTN Harvest is clicked" << std::endl;
-                        gh->harvestPlant(selectedPlotIndex);
-                        selectedPlotIndex = -1;
+                        gh->harvestPlant(selectedPlot);
+                        selectedPlot = PlotHandle();
                     }
-                    else if (plant->isDead())
+                    else if (plant.isDead())
                     {
-                        gh->removePlant(selectedPlotIndex);
-                        selectedPlotIndex = -1;
+                        gh->removePlant(selectedPlot.index);
+                        selectedPlot = PlotHandle();
                     }
-                    // std::cout << "LOG: Action executed on plot " << selectedPlotIndex << std::endl;
+                    // std::cout << "LOG: Action executed on plot " << selectedPlot.index << std::endl;
                     return;
                 }
             }
         }
 
         // Check Plot Clicks (Priority 2: Only if menu buttons were missed)
+        // The open inspector bar covers the plots behind it
+        if (!CheckCollisionPointRec(mousePos, GRID_VIEW) || (!selectedPlot.isNull() && mousePos.y >= INSPECTOR_BAR_Y))
+            return;
         Greenhouse *gh = Game::getInstance()->getPlayerPtr()->getPlot();
-        int plotIndex = 0;
-        int numGridBlocks = 15; // 8 plots + 7 paths
-        int currentX = GRID_START_X;
-        int currentY = GRID_START_Y;
-
-        // Replicate the draw loop structure to find the collision point:
-        for (int row = 0; row < numGridBlocks; row++)
+        layout.update(gh->getCapacity());
+        int plotIndex = layout.plotAt(GetScreenToWorld2D(mousePos, camera));
+        if (plotIndex >= 0)
         {
-            currentX = GRID_START_X;
-            bool isPathRow = (row % 2 != 0);
-            int blockHeight = isPathRow ? PATH_SIZE : PLOT_SIZE;
-
-            for (int col = 0; col < numGridBlocks; col++)
-            {
-                bool isPathCol = (col % 2 != 0);
-                int blockWidth;
-                if (isPathCol && col == MIDDLE_PATH_INDEX)
-                {
-                    blockWidth = NARROW_PATH_WIDTH;
-                }
-                else
-                {
-                    blockWidth = isPathCol ? PATH_SIZE : PLOT_SIZE;
-                    
-                }
-
-                bool isPlotTile = !isPathRow && !isPathCol;
-                Rectangle rect = {(float)currentX, (float)currentY, (float)blockWidth, (float)blockHeight};
-
-                if (isPlotTile)
-                {
-                    if (plotIndex < gh->getCapacity())
-                    {
-
-                        // Check collision only once per frame
-                        if (CheckCollisionPointRec(mousePos, rect))
-                        {
-                            selectedPlotIndex = (selectedPlotIndex == plotIndex) ? -1 : plotIndex;
-                            // std::cout << "LOG: Clicked plot index: " << selectedPlotIndex << std::endl;
-                            return; // Stop checking other plots
-                        }
-                        plotIndex++;
-                    }
-                }
-                currentX += blockWidth;
-            }
-            currentY += blockHeight;
+            selectedPlot = (selectedPlot.index == plotIndex) ? PlotHandle() : gh->getHandle(plotIndex);
+            // std::cout << "LOG: Clicked plot index: " << selectedPlot.index << std::endl;
         }
     }
 }
@@ -278,93 +232,162 @@ SceneType GreenHouseScene::CheckExit()
     return result;
 }
 
-// --- DRAWING ---
-void GreenHouseScene::Draw()
+void GreenHouseScene::HandleCameraInput()
 {
-    const int screenWidth = SCREEN_WIDTH;
-    const int screenHeight = SCREEN_HEIGHT;
+    Vector2 mousePos = GetMousePosition();
 
-    // 1. Draw the base textured soil background for the entire scene.
-    DrawTiledBackground(GetSoilColor(), screenWidth, screenHeight);
+    // Zoom towards whatever is under the cursor
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f && CheckCollisionPointRec(mousePos, GRID_VIEW))
+    {
+        camera.target = GetScreenToWorld2D(mousePos, camera);
+        camera.offset = mousePos;
+        camera.zoom *= 1.0f + ZOOM_STEP * wheel;
+        if (camera.zoom < MIN_ZOOM)
+            camera.zoom = MIN_ZOOM;
+        if (camera.zoom > MAX_ZOOM)
+            camera.zoom = MAX_ZOOM;
+    }
 
-    Greenhouse *gh = Game::getInstance()->getPlayerPtr()->getPlot();
+    // Drag with the right button, or use the arrow keys
+    if (IsMouseButtonDown(MOUSE_RIGHT_BUTTON))
+    {
+        Vector2 delta = GetMouseDelta();
+        camera.target.x -= delta.x / camera.zoom;
+        camera.target.y -= delta.y / camera.zoom;
+    }
+    float step = PAN_SPEED * GetFrameTime() / camera.zoom;
+    if (IsKeyDown(KEY_LEFT)) camera.target.x -= step;
+    if (IsKeyDown(KEY_RIGHT)) camera.target.x += step;
+    if (IsKeyDown(KEY_UP)) camera.target.y -= step;
+    if (IsKeyDown(KEY_DOWN)) camera.target.y += step;
 
-    Plant *inspectorPlant = nullptr;
+    ClampCamera();
+}
+
+void GreenHouseScene::ClampCamera()
+{
+    // Keep the middle of the view over the greenhouse so it can't be lost
+    layout.update(Game::getInstance()->getPlayerPtr()->getPlot()->getCapacity());
+    Rectangle bounds = layout.getBounds();
+    Vector2 center = GetScreenToWorld2D(Vector2{GRID_VIEW.x + GRID_VIEW.width / 2.0f, GRID_VIEW.y + GRID_VIEW.height / 2.0f}, camera);
+
+    if (center.x < bounds.x)
+        camera.target.x += bounds.x - center.x;
+    else if (center.x > bounds.x + bounds.width)
+        camera.target.x -= center.x - (bounds.x + bounds.width);
+    if (center.y < bounds.y)
+        camera.target.y += bounds.y - center.y;
+    else if (center.y > bounds.y + bounds.height)
+        camera.target.y -= center.y - (bounds.y + bounds.height);
+}
+
+Rectangle GreenHouseScene::GetVisibleWorldRect() const
+{
+    Vector2 topLeft = GetScreenToWorld2D(Vector2{GRID_VIEW.x, GRID_VIEW.y}, camera);
+    Vector2 bottomRight = GetScreenToWorld2D(Vector2{GRID_VIEW.x + GRID_VIEW.width, GRID_VIEW.y + GRID_VIEW.height}, camera);
+    // Plants stick out of their plots, so a chunk just off screen can
+    // still reach into view
+    return Rectangle{topLeft.x - PLOT_SIZE, topLeft.y - PLOT_SIZE,
+                     bottomRight.x - topLeft.x + 2 * PLOT_SIZE, bottomRight.y - topLeft.y + 2 * PLOT_SIZE};
+}
+
+// Flat tile for plots too small on screen to show a plant
+static Color PlotTileColor(const Plant *plant)
+{
+    if (plant->isDead())
+        return BROWN;
+    if (plant->isRipe())
+        return GOLD;
+    float growth = plant->getGrowth() / 100.0f;
+    return Color{(unsigned char)(60 - 40 * growth), (unsigned char)(120 + 80 * growth), (unsigned char)(40 + 10 * growth), 255};
+}
 
-    // --- Dynamic Grid Drawing ---
-    int plotIndex = 0;
-    int numGridBlocks = 15;
-    int currentX = GRID_START_X;
-    int currentY = GRID_START_Y;
-    for (int row = 0; row < numGridBlocks; row++)
+// --- DRAWING ---
+void GreenHouseScene::DrawGround(Vector2 origin)
+{
+    DrawTiledArea(Rectangle{origin.x, origin.y, (float)GreenhouseLayout::CHUNK_WIDTH, (float)GreenhouseLayout::CHUNK_HEIGHT}, GetSoilColor());
+    for (const Rectangle &path : layout.getChunkPathRects())
     {
-        currentX = GRID_START_X;
-        bool isPathRow = (row % 2 != 0);
-        int blockHeight = isPathRow ? PATH_SIZE : PLOT_SIZE;
+        DrawTiledArea(Rectangle{origin.x + path.x, origin.y + path.y, path.width, path.height}, GetPathColor());
+    }
+}
 
-        // Check if this row is outside the new available area (bottom bar takes space)
-        if (currentY + blockHeight > INSPECTOR_BAR_Y)
-        {
-            break; // Stop drawing grid blocks that overlap the inspector bar
-        }
+void GreenHouseScene::Draw()
+{
+    Greenhouse *gh = Game::getInstance()->getPlayerPtr()->getPlot();
+    layout.update(gh->getCapacity());
 
-        for (int col = 0; col < numGridBlocks; col++)
-        {
-            bool isPathCol = (col % 2 != 0);
-            int blockWidth;
-            if (isPathCol && col == MIDDLE_PATH_INDEX)
-            {
-                blockWidth = NARROW_PATH_WIDTH;
-            }
-            else
-            {
-                blockWidth = isPathCol ? PATH_SIZE : PLOT_SIZE;
-            }
+    PlotSnapshot inspectorPlant;
 
-            bool isPlotTile = !isPathRow && !isPathCol;
-            Rectangle rect = {(float)currentX, (float)currentY, (float)blockWidth, (float)blockHeight};
+    // Plants are drawn from the sprite atlas, all at once after the grid
+    PlantSpriteCache &sprites = PlantSpriteCache::getInstance();
+    sprites.build(PLOT_SIZE);
 
-            if (isPlotTile)
-            {
-                if (plotIndex < gh->getCapacity())
-                {
-                    Plant *plant = gh->getPlant(plotIndex);
+    BeginScissorMode((int)GRID_VIEW.x, (int)GRID_VIEW.y, (int)GRID_VIEW.width, (int)GRID_VIEW.height);
+    DrawRectangleRec(GRID_VIEW, GetSoilColor());
+    BeginMode2D(camera);
 
-                    if (plant)
-                    {
-                        float plantDrawX = rect.x + rect.width / 2.0f;
-                        float plantDrawY = rect.y + rect.height;
-                        plant->draw(plantDrawX, plantDrawY, PLOT_SIZE * 0.8f, PLOT_SIZE);
-                    }
+    // Only chunks overlapping the view are touched at all
+    Rectangle visible = GetVisibleWorldRect();
+    std::vector<int> visibleChunks;
+    for (int chunk = 0; chunk < layout.getChunkCount(); chunk++)
+    {
+        if (CheckCollisionRecs(layout.getChunkRect(chunk), visible))
+            visibleChunks.push_back(chunk);
+    }
 
-                    // Store Inspector Data
-                    if (selectedPlotIndex == plotIndex)
-                    {
-                        inspectorPlant = plant;
-                    }
+    // 1. Soil and paths, pre-drawn once and stamped down per chunk
+    for (int chunk : visibleChunks)
+    {
+        const Rectangle &rect = layout.getChunkRect(chunk);
+        groundLayer.draw(Vector2{rect.x, rect.y}, [&]() { DrawGround(Vector2{rect.x, rect.y}); });
+    }
 
-                    plotIndex++;
-                }
-            }
-            else if (isPathRow)
-            {
-                DrawTiledArea(rect, GetPathColor());
-            }
-            else if (isPathCol && col == MIDDLE_PATH_INDEX)
-            {
-                DrawTiledArea(rect, GetPathColor());
-            }
+    // --- Plots ---
+    for (int chunk : visibleChunks)
+    {
+        int firstPlot = chunk * Greenhouse::PLOTS_PER_CHUNK;
+        int endPlot = std::min(firstPlot + Greenhouse::PLOTS_PER_CHUNK, layout.getPlotCount());
+        for (int plotIndex = firstPlot; plotIndex < endPlot; plotIndex++)
+        {
+            const Rectangle &rect = layout.getPlotRect(plotIndex);
 
-            currentX += blockWidth;
+            // Drawn with the plot locked: workers may be tending it right now
+            gh->withPlant(gh->getHandle(plotIndex), [&](Plant *plant) {
+                float plantDrawX = rect.x + rect.width / 2.0f;
+                float plantDrawY = rect.y + rect.height;
+                if (camera.zoom < SPRITE_ZOOM)
+                {
+                    DrawRectangleRec(rect, PlotTileColor(plant));
+                }
+                else if (camera.zoom >= DETAIL_ZOOM ||
+                         !sprites.queue(plant->getTypeId(), plant->getGrowth(), plant->isDead(), plantDrawX, plantDrawY))
+                {
+                    const PlantDescriptor *crop = plant->getDescriptor();
+                    float width = crop ? crop->width : 0.8f;
+                    float height = crop ? crop->height : 1.0f;
+                    plant->draw(plantDrawX, plantDrawY, PLOT_SIZE * width, PLOT_SIZE * height);
+                }
+            });
         }
+    }
+
+    sprites.flush();
+
+    EndMode2D();
+    EndScissorMode();
 
-        currentY += blockHeight;
+    // Store Inspector Data
+    if (!selectedPlot.isNull() && selectedPlot.index < layout.getPlotCount())
+    {
+        inspectorPlant = gh->inspect(selectedPlot);
     }
 
     DrawGreenhouse(); // Draws scene title
 
     // --- FINAL LAYER: DRAW PLANT INSPECTOR BAR (New Horizontal State Bar) ---
-    if (selectedPlotIndex != -1)
+    if (!selectedPlot.isNull())
     {
         DrawPlantInspector(inspectorPlant, {INSPECTOR_BAR_X, INSPECTOR_BAR_Y});
     }
@@ -442,17 +465,20 @@ void GreenHouseScene::DrawSeedShop()
     // --- Seed Items Loop ---
     int startY = SHOP_Y + 80;
 
-    for (const auto &pair : plantCatalog)
+    // Every crop in the registry is on sale
+    for (int type = 0; type < PlantTypes::count(); type++)
     {
-        const std::string &type = pair.first;
-        float price = std::get<0>(pair.second);
-        PlantFactory *factory = std::get<1>(pair.second).get();
-        PlantVisualStrategy *visual = std::get<2>(pair.second).get();
+        const PlantDescriptor *crop = PlantTypes::describe((PlantTypeId)type);
+        if (!crop)
+            continue;
+        float price = crop->seedPrice;
+        const PlantVisualStrategy *visual = PlantVisualFactory::getInstance().getVisual((PlantTypeId)type);
 
         Rectangle itemRect = {SHOP_X + 20, (float)startY, SHOP_WIDTH - 40, ITEM_ROW_HEIGHT - 10};
         DrawRectangleRec(itemRect, Fade(DARKGRAY, 0.2f));
-        visual->drawStatic(SHOP_X + 60, (float)startY + ITEM_ROW_HEIGHT / 2);
-        DrawText(type.c_str(), SHOP_X + 110, startY + 10, 20, RAYWHITE);
+        if (visual)
+            visual->drawStatic(SHOP_X + 60, (float)startY + ITEM_ROW_HEIGHT / 2);
+        DrawText(crop->name, SHOP_X + 110, startY + 10, 20, RAYWHITE);
         DrawText(TextFormat("$%.2f", price), SHOP_X + 110, startY + 35, 18, GOLD);
 
         Rectangle buyBtn = {SHOP_X + SHOP_WIDTH - 120, (float)startY + 10, 100, ITEM_ROW_HEIGHT - 20};
@@ -478,7 +504,7 @@ void GreenHouseScene::DrawSeedShop()
                 else
                 {
 
-                    Plant *newPlant = factory->produce();
+                    Plant *newPlant = PlantTypes::create((PlantTypeId)type);
                     if (greenhouse->addPlant(newPlant))
                     {
                         player->getPlot()->notify();
@@ -588,7 +614,7 @@ void GreenHouseScene::DrawHireShop()
 }
 
 // Draw Plant Inspector Function
-void GreenHouseScene::DrawPlantInspector(Plant *plant, Vector2 drawPos)
+void GreenHouseScene::DrawPlantInspector(const PlotSnapshot &plant, Vector2 drawPos)
 {
 
     // Note: drawPos is ignored; position is fixed to INSPECTOR_BAR_X/Y
@@ -611,7 +637,7 @@ void GreenHouseScene::DrawPlantInspector(Plant *plant, Vector2 drawPos)
     float textY = barRect.y + padding;
     float textX = barRect.x + padding;
 
-    if (!plant)
+    if (plant.isEmpty())
     {
         DrawText("PLOT: EMPTY", textX, textY, 20, RAYWHITE);
         DrawText("Click a plant to inspect its status.", textX, textY + 30, 15, GRAY);
@@ -619,7 +645,7 @@ void GreenHouseScene::DrawPlantInspector(Plant *plant, Vector2 drawPos)
     }
 
     // 2. Display Status (Left/Center Column Area)
-    DrawText(plant->getType().c_str(), textX, textY, 20, LIME);
+    DrawText(plant.getType().c_str(), textX, textY, 20, LIME);
     textY += 35;
 
     // Column 2 X-position for stats
@@ -627,18 +653,18 @@ void GreenHouseScene::DrawPlantInspector(Plant *plant, Vector2 drawPos)
     float statY = barRect.y + padding + 35; // Y start for stats
 
     // Row 1 (State & Water)
-    DrawText(TextFormat("State: %s", plant->getStateName().c_str()), textX, textY, 15, RAYWHITE);
-    DrawText(TextFormat("Water: %.0f%%", plant->getWater()), col2X, statY, 15, SKYBLUE);
+    DrawText(TextFormat("State: %s", plant.getStateName()), textX, textY, 15, RAYWHITE);
+    DrawText(TextFormat("Water: %.0f%%", plant.water), col2X, statY, 15, SKYBLUE);
     textY += 20;
     statY += 20;
 
     // Row 2 (Growth & Nutrients)
-    DrawText(TextFormat("Growth: %.0f%%", plant->getGrowth()), textX, textY, 15, WHITE);
-    DrawText(TextFormat("Nutrients: %.0f%%", plant->getNutrients()), col2X, statY, 15, BROWN);
+    DrawText(TextFormat("Growth: %.0f%%", plant.growth), textX, textY, 15, WHITE);
+    DrawText(TextFormat("Nutrients: %.0f%%", plant.nutrients), col2X, statY, 15, BROWN);
 
     // --- 3. Interaction Buttons (3x2 Grid Alignment) ---
     Greenhouse *greenhouse = Game::getInstance()->getPlayerPtr()->getPlot();
-    const int targetPlot = selectedPlotIndex;
+    const PlotHandle targetPlot = selectedPlot;
 
     // Starting X and Y for the button grid
     float btnGridX = textX + 450; // Shift far right, outside of stat text
@@ -656,8 +682,8 @@ void GreenHouseScene::DrawPlantInspector(Plant *plant, Vector2 drawPos)
     DrawText("WATER", btnWater.x + 5, btnWater.y + 10, 15, DARKBLUE);
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), btnWater))
     {
-        plant->water(10.0f);
-        // std::cout << "LOG: Watered plot " << targetPlot << std::endl;
+        greenhouse->withPlant(targetPlot, [](Plant *p) { p->water(10.0f); });
+        // std::cout << "LOG: Watered plot " << targetPlot.index << std::endl;
     }
 
     // b. Fertilize Button (R1, C2)
@@ -665,8 +691,8 @@ void GreenHouseScene::DrawPlantInspector(Plant *plant, Vector2 drawPos)
     DrawText("FERTILIZE", btnFert.x + 5, btnFert.y + 10, 15, WHITE);
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), btnFert))
     {
-        plant->fertilize(5.0f);
-        // std::cout << "LOG: Fertilized plot " << targetPlot << std::endl;
+        greenhouse->withPlant(targetPlot, [](Plant *p) { p->fertilize(5.0f); });
+        // std::cout << "LOG: Fertilized plot " << targetPlot.index << std::endl;
     }
 
     // c. DELETE Button (R2, C2 - Permanent Removal)
@@ -675,35 +701,32 @@ void GreenHouseScene::DrawPlantInspector(Plant *plant, Vector2 drawPos)
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), btnDelete))
     {
         // DELETE command should work regardless of state (used for accidental planting/cleanup)
-        greenhouse->removePlant(targetPlot);
-        selectedPlotIndex = -1;
-        // std::cout << "LOG: Permanently deleted plant from plot " << targetPlot << std::endl;
+        greenhouse->removePlant(targetPlot.index);
+        selectedPlot = PlotHandle();
+        // std::cout << "LOG: Permanently deleted plant from plot " << targetPlot.index << std::endl;
     }
 
     // d. Harvest/Deroot/Growing Action Button (R2, C1 - Conditional)
-    if (plant->isRipe())
+    if (plant.isRipe())
     {
         DrawRectangleRec(btnAction, LIME);
         DrawText("HARVEST", btnAction.x + 5, btnAction.y + 10, 15, BLACK);
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), btnAction))
         {
             greenhouse->harvestPlant(targetPlot);
-            selectedPlotIndex = -1;
-            plant = nullptr; // <--- ADDED: Manually invalidate the local plant pointer
-            selectedPlotIndex = -1;
-            // std::cout << "LOG: Harvested plot " << targetPlot << std::endl;
+            selectedPlot = PlotHandle();
+            // std::cout << "LOG: Harvested plot " << targetPlot.index << std::endl;
         }
     }
-    else if (plant->isDead())
+    else if (plant.isDead())
     {
         DrawRectangleRec(btnAction, MAROON);
         DrawText("DEROOT", btnAction.x + 5, btnAction.y + 10, 15, WHITE);
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), btnAction))
         {
-            greenhouse->removePlant(targetPlot);
-            plant = nullptr; // Manually invalidate the local plant pointer
-            selectedPlotIndex = -1;
-            // std::cout << "LOG: Derooted dead plant from plot " << targetPlot << std::endl;
+            greenhouse->removePlant(targetPlot.index);
+            selectedPlot = PlotHandle();
+            // std::cout << "LOG: Derooted dead plant from plot " << targetPlot.index << std::endl;
         }
     }
     else
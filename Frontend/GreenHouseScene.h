@@ -9,7 +9,11 @@
 #include "../Backend/PlantFactory.h"
 #include "../Backend/Inventory.h"
 #include "PlantVisualStrategy.h"
+#include "PlantSpriteCache.h"
+#include "CachedLayer.h"
+#include "GreenhouseLayout.h"
 #include "../Backend/Worker.h"
+#include "../Backend/PlotHandle.h"
 #include "UI.h"
 #include <map>
 #include <vector>
@@ -32,27 +36,35 @@
 #define SHOP_Y ((SCREEN_HEIGHT - SHOP_HEIGHT) / 2)
 #define ITEM_ROW_HEIGHT 60
 
-extern std::map<std::string, std::tuple<float, std::unique_ptr<PlantFactory>, std::unique_ptr<PlantVisualStrategy>>> plantCatalog;
-
 class GreenHouseScene : public Scene {
 private:
     PlantVisual plants[MAX_PLANTS];
     Road paths[10];
     int numPlants;
     int numPaths;
-    int selectedPlotIndex;
+    PlotHandle selectedPlot;   // goes stale when the plot's plant changes
     bool isShopOpen;
     bool isHireShopOpen;
-    float simTimeAccumulator;
 
     SceneType nextScene;
 
+    // Plot and path rectangles in world space, shared by drawing and input
+    GreenhouseLayout layout;
+    // Soil and path tiles of one chunk; every chunk reuses it
+    CachedLayer groundLayer;
+    // Pans and zooms over the plots; the menu and inspector stay put
+    Camera2D camera;
+
     void InitPlants();
     void InitPaths();
+    void HandleCameraInput();
+    void ClampCamera();
+    Rectangle GetVisibleWorldRect() const;
+    void DrawGround(Vector2 origin);
     void DrawPlantDetailed(PlantVisual p);
     void DrawSeedShop();
     void DrawHireShop();
-    void DrawPlantInspector(Plant* plant, Vector2 drawPos);
+    void DrawPlantInspector(const PlotSnapshot& plant, Vector2 drawPos);
     void DrawGate(Vector2 position, bool isVertical);
     void DrawGreenhouse();
     float Distance(Vector2 a, Vector2 b);
@@ -0,0 +1,116 @@
+#include "GreenhouseLayout.h"
+
+static int ColumnWidth(int col)
+{
+    if (col % 2 == 0)
+        return GreenhouseLayout::PLOT_SIZE;
+    return col == GreenhouseLayout::MIDDLE_PATH_INDEX ? GreenhouseLayout::NARROW_PATH_WIDTH : GreenhouseLayout::PATH_SIZE;
+}
+
+static Vector2 ChunkOrigin(int chunk)
+{
+    return Vector2{(float)(GreenhouseLayout::GRID_START_X + (chunk % GreenhouseLayout::CHUNK_COLUMNS) * GreenhouseLayout::CHUNK_WIDTH),
+                   (float)(GreenhouseLayout::GRID_START_Y + (chunk / GreenhouseLayout::CHUNK_COLUMNS) * GreenhouseLayout::CHUNK_HEIGHT)};
+}
+
+GreenhouseLayout::GreenhouseLayout()
+    : capacity(-1)
+{
+    // Every chunk is the same, so its paths and lookup tables are worked
+    // out once here
+    int x = 0;
+    for (int col = 0; col < GRID_BLOCKS; col++)
+    {
+        bool isPathCol = (col % 2 != 0);
+        if (!isPathCol)
+            columnX.push_back((float)x);
+        columnAtX.insert(columnAtX.end(), ColumnWidth(col), isPathCol ? -1 : (int)columnX.size() - 1);
+        x += ColumnWidth(col);
+    }
+    int contentWidth = x;
+    columnAtX.resize(CHUNK_WIDTH, -1);
+
+    int y = 0;
+    int rows = 0;
+    for (int row = 0; row < GRID_BLOCKS; row++)
+    {
+        bool isPathRow = (row % 2 != 0);
+        int blockHeight = isPathRow ? PATH_SIZE : PLOT_SIZE;
+
+        x = 0;
+        for (int col = 0; col < GRID_BLOCKS; col++)
+        {
+            // Side paths only run between plot rows; the middle one goes all the way
+            if (isPathRow || col == MIDDLE_PATH_INDEX)
+            {
+                chunkPaths.push_back(Rectangle{(float)x, (float)y, (float)ColumnWidth(col), (float)blockHeight});
+            }
+            x += ColumnWidth(col);
+        }
+
+        rowAtY.insert(rowAtY.end(), blockHeight, isPathRow ? -1 : rows);
+        if (!isPathRow)
+            rows++;
+        y += blockHeight;
+    }
+    rowAtY.resize(CHUNK_HEIGHT, -1);
+
+    // The paths between chunks
+    chunkPaths.push_back(Rectangle{0.0f, (float)y, (float)contentWidth, (float)(CHUNK_HEIGHT - y)});
+    chunkPaths.push_back(Rectangle{(float)contentWidth, 0.0f, (float)(CHUNK_WIDTH - contentWidth), (float)CHUNK_HEIGHT});
+}
+
+void GreenhouseLayout::update(int newCapacity)
+{
+    if (newCapacity == capacity)
+        return;
+    capacity = newCapacity;
+
+    plots.clear();
+    chunks.clear();
+    for (int plot = 0; plot < capacity; plot++)
+    {
+        int chunk = plot / Greenhouse::PLOTS_PER_CHUNK;
+        int local = plot % Greenhouse::PLOTS_PER_CHUNK;
+        Vector2 origin = ChunkOrigin(chunk);
+        if (local == 0)
+        {
+            chunks.push_back(Rectangle{origin.x, origin.y, (float)CHUNK_WIDTH, (float)CHUNK_HEIGHT});
+        }
+        int row = local / CHUNK_SIDE;
+        int col = local % CHUNK_SIDE;
+        plots.push_back(Rectangle{origin.x + columnX[col], origin.y + row * (PLOT_SIZE + PATH_SIZE),
+                                  (float)PLOT_SIZE, (float)PLOT_SIZE});
+    }
+}
+
+Rectangle GreenhouseLayout::getBounds() const
+{
+    if (chunks.empty())
+        return Rectangle{(float)GRID_START_X, (float)GRID_START_Y, 0.0f, 0.0f};
+    int chunkRows = (getChunkCount() + CHUNK_COLUMNS - 1) / CHUNK_COLUMNS;
+    int chunkColumns = getChunkCount() < CHUNK_COLUMNS ? getChunkCount() : CHUNK_COLUMNS;
+    return Rectangle{(float)GRID_START_X, (float)GRID_START_Y,
+                     (float)(chunkColumns * CHUNK_WIDTH), (float)(chunkRows * CHUNK_HEIGHT)};
+}
+
+int GreenhouseLayout::plotAt(Vector2 point) const
+{
+    if (point.x < GRID_START_X || point.y < GRID_START_Y)
+        return -1;
+    int px = (int)point.x - GRID_START_X;
+    int py = (int)point.y - GRID_START_Y;
+
+    int chunkColumn = px / CHUNK_WIDTH;
+    if (chunkColumn >= CHUNK_COLUMNS)
+        return -1;
+    int chunk = (py / CHUNK_HEIGHT) * CHUNK_COLUMNS + chunkColumn;
+
+    int column = columnAtX[px % CHUNK_WIDTH];
+    int row = rowAtY[py % CHUNK_HEIGHT];
+    if (column < 0 || row < 0)
+        return -1;
+
+    int plot = chunk * Greenhouse::PLOTS_PER_CHUNK + row * CHUNK_SIDE + column;
+    return plot < getPlotCount() ? plot : -1;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "raylib.h"
+#include "../Backend/Greenhouse.h"
+#include <vector>
+
+// World geometry of the greenhouse: plots come in square chunks of
+// CHUNK_SIDE x CHUNK_SIDE, the same 64-plot chunks the Greenhouse stores
+// them in. Inside a chunk, plot tiles are separated by paths with a
+// narrower one down the middle; a full-width path runs between chunks.
+// Chunks are laid out CHUNK_COLUMNS to a row, so the world only grows
+// downwards and to the right and a plot never moves once it exists.
+// Coordinates are world units; the scene's camera maps them to the screen.
+class GreenhouseLayout
+{
+public:
+    static constexpr int GRID_START_X = 50;
+    static constexpr int GRID_START_Y = 50;
+    static constexpr int PLOT_SIZE = 90;
+    static constexpr int PATH_SIZE = 50;
+    static constexpr int NARROW_PATH_WIDTH = 30;
+    static constexpr int MIDDLE_PATH_INDEX = 7;
+    static constexpr int GRID_BLOCKS = 15;      // plots and paths per side of a chunk
+    static constexpr int CHUNK_SIDE = (GRID_BLOCKS + 1) / 2;
+    static constexpr int CHUNK_COLUMNS = 8;
+
+    // Size of a chunk including the path that follows it
+    static constexpr int CHUNK_WIDTH = CHUNK_SIDE * PLOT_SIZE + (CHUNK_SIDE - 2) * PATH_SIZE + NARROW_PATH_WIDTH + PATH_SIZE;
+    static constexpr int CHUNK_HEIGHT = CHUNK_SIDE * PLOT_SIZE + CHUNK_SIDE * PATH_SIZE;
+
+    static_assert(CHUNK_SIDE * CHUNK_SIDE == Greenhouse::PLOTS_PER_CHUNK,
+                  "view chunks must match the greenhouse's storage chunks");
+
+    GreenhouseLayout();
+
+    // Lays out `capacity` plots. Cheap to call every frame: nothing
+    // happens unless the capacity changed.
+    void update(int capacity);
+
+    // Plots laid out, indexed like greenhouse plots
+    int getPlotCount() const { return (int)plots.size(); }
+    const Rectangle& getPlotRect(int index) const { return plots[index]; }
+
+    // Chunks holding at least one plot; chunk c holds plots c*64 .. c*64+63
+    int getChunkCount() const { return (int)chunks.size(); }
+    const Rectangle& getChunkRect(int chunk) const { return chunks[chunk]; }
+    // Smallest rectangle around every chunk
+    Rectangle getBounds() const;
+
+    // Path tiles of one chunk, relative to its top-left corner. Every chunk
+    // has the same ones, so the ground can be drawn once and reused.
+    const std::vector<Rectangle>& getChunkPathRects() const { return chunkPaths; }
+
+    // Plot under the world point, or -1 for paths and anything off the grid
+    int plotAt(Vector2 point) const;
+
+private:
+    int capacity;
+    std::vector<Rectangle> plots;
+    std::vector<Rectangle> chunks;
+    std::vector<Rectangle> chunkPaths;
+
+    // Lookup within a chunk, one entry per unit along each axis: which plot
+    // column (or row) covers it, -1 on a path. Turns a hit test into a few
+    // divisions and two reads.
+    std::vector<int> columnAtX;
+    std::vector<int> rowAtY;
+    std::vector<float> columnX;     // left edge of each plot column inside a chunk
+};
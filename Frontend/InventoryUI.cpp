@@ -8,8 +8,6 @@
 #include "PlantVisualStrategy.h"
 
 
-extern std::map<std::string, std::tuple<float, PlantFactory *, PlantVisualStrategy *>> plantCatalog;
-
 InventoryUI::InventoryUI(Inventory* inv)
     : inventory(inv), isOpen(false), selectedSlotIndex(-1), timeSinceLastUpdate(0.0f)
 {
@@ -33,7 +31,7 @@ void InventoryUI::toggle()
             {
                 Rectangle tempRect = {j, i, 75, 75};
 
-                const InventorySlot* slotData = nullptr;
+                InventorySlot slotData;
                 if (invPos < inventory->getMaxSlots())
                 {
                     slotData = inventory->getSlot(invPos);
@@ -79,27 +77,21 @@ void InventoryUI::render()
 
         DrawRectangleLinesEx(slot.rect, 2, BLACK);
 
-        if (slot.slot != nullptr && !slot.slot->isEmpty())
+        if (!slot.slot.isEmpty())
         {
-            std::string itemName = slot.slot->getPlantType();
-
-
-            auto it = plantCatalog.find(itemName); 
+            const std::string& itemName = slot.slot.getPlantType();
+            const PlantVisualStrategy* visualStrategy = PlantVisualFactory::getInstance().getVisual(slot.slot.getPlantTypeId());
             
-            if (it != plantCatalog.end()) {
-                PlantVisualStrategy* visualStrategy = std::get<2>(it->second);
-                
-                if (visualStrategy) {
-                    float drawX = slot.rect.x + slot.rect.width / 2.0f;
-                    float drawY = slot.rect.y + slot.rect.height / 2.0f - 5.0f; 
-
-                    visualStrategy->drawStatic(drawX, drawY); 
-                }
+            if (visualStrategy) {
+                float drawX = slot.rect.x + slot.rect.width / 2.0f;
+                float drawY = slot.rect.y + slot.rect.height / 2.0f - 5.0f; 
+
+                visualStrategy->drawStatic(drawX, drawY); 
             } else {
                 DrawCircle(slot.rect.x + 37, slot.rect.y + 37, 20, GREEN);
             }
 
-            std::string quantity = std::to_string(slot.slot->getSize());
+            std::string quantity = std::to_string(slot.slot.getSize());
             DrawText(quantity.c_str(), slot.rect.x + 5, slot.rect.y + 5, 10, WHITE);
             
             // Draw item name, centered near the bottom of the slot
@@ -141,38 +133,20 @@ void InventoryUI::update()
                 // CASE 1: A slot is selected - swap/merge within inventory
                 if (selectedSlotIndex != -1 && selectedSlotIndex != i)
                 {
-                    const InventorySlot* sourceSlot = inventory->getSlot(selectedSlotIndex);
-                    const InventorySlot* destSlot = inventory->getSlot(i);
+                    const InventorySlot sourceSlot = inventory->getSlot(selectedSlotIndex);
+                    const InventorySlot destSlot = inventory->getSlot(i);
 
                     bool shouldMerge = false;
-                    if (sourceSlot && destSlot &&
-                        !sourceSlot->isEmpty() && !destSlot->isEmpty() &&
-                        sourceSlot->getPlantType() == destSlot->getPlantType() &&
-                        !destSlot->isFull())
+                    if (!sourceSlot.isEmpty() && !destSlot.isEmpty() &&
+                        sourceSlot.getPlantTypeId() == destSlot.getPlantTypeId() &&
+                        !destSlot.isFull())
                     {
                         shouldMerge = true;
                     }
 
                     if (shouldMerge)
                     {
-                        std::string plantType = sourceSlot->getPlantType();
-                        int spaceAvailable = destSlot->getRemainingCapacity();
-                        int itemsInSource = sourceSlot->getSize();
-                        int itemsToMove = std::min(spaceAvailable, itemsInSource);
-
-                        for (int j = 0; j < itemsToMove; j++)
-                        {
-                            const InventorySlot* currentDestSlot = inventory->getSlot(i);
-                            if (!currentDestSlot || currentDestSlot->isFull())
-                                break;
-
-                            Plant* plant = inventory->removeItem(plantType);
-                            if (!plant)
-                                break;
-                            
-                            // Reverting to base add/remove due to missing function:
-                            if (!inventory->add(plant)) { delete plant; break; }
-                        }
+                        inventory->mergeSlots(selectedSlotIndex, i);
                     }
                     else
                     {
@@ -188,7 +162,7 @@ void InventoryUI::update()
                 else if (selectedSlotIndex == -1)
                 {
                     // Only select if slot has items
-                    if (slotVector[i].slot != nullptr && !slotVector[i].slot->isEmpty())
+                    if (!slotVector[i].slot.isEmpty())
                     {
                         selectedSlotIndex = i;
                         slotVector[i].selected = true;
@@ -5,7 +5,7 @@
 
 // --- OutdoorScene Class Implementation ---
 
-OutdoorScene::OutdoorScene() : timeOfDay(0.6f), isPaused(false), numRoads(0), numTrees(0), numPlants(0), nextScene(SCENE_OUTDOOR) {}
+OutdoorScene::OutdoorScene() : timeOfDay(0.6f), isPaused(false), numRoads(0), numTrees(0), numPlants(0), nextScene(SCENE_OUTDOOR), layerGrass{0, 0, 0, 0}, layerDaytime(false) {}
 
 void OutdoorScene::Init() {
     // Reset all counters to prevent accumulation on re-initialization
@@ -29,6 +29,9 @@ void OutdoorScene::Init() {
         timeOfDay = h / 24.0f + m / (24.0f * 60.0f);
     }
 
+    // Trees and houses were just re-placed
+    staticLayer.invalidate();
+    RefreshStaticLayer();
 }
 
 void OutdoorScene::InitBuildings() {
@@ -273,7 +276,7 @@ SceneType OutdoorScene::CheckExit() {
     return result;
 }
 
-void OutdoorScene::Draw() {
+void OutdoorScene::DrawStaticLayer() {
     DrawTiledBackground(GetGrassColor(), 1400, 900);
 
     for (int i = 0; i < numRoads; i++) {
@@ -321,7 +324,22 @@ void OutdoorScene::Draw() {
     for (int i = 0; i < numTrees; i++) {
         if (trees[i].position.y >= 400) DrawTreeDetailed(trees[i]);
     }
+}
+
+void OutdoorScene::RefreshStaticLayer() {
+    Color grass = GetGrassColor();
+    bool daytime = IsDaytime();
+    bool sameGrass = grass.r == layerGrass.r && grass.g == layerGrass.g && grass.b == layerGrass.b;
+    if (staticLayer.isValid() && sameGrass && daytime == layerDaytime) return;
+
+    layerGrass = grass;
+    layerDaytime = daytime;
+    staticLayer.rebuild(1400, 900, [this]() { DrawStaticLayer(); });
+}
 
+void OutdoorScene::Draw() {
+    RefreshStaticLayer();
+    staticLayer.draw([this]() { DrawStaticLayer(); });
 
     for (int i = 0; i < MAX_PEOPLE; i++) {
         DrawPersonDetailed(people[i]);
@@ -360,6 +378,10 @@ Color OutdoorScene::GetSkyColor() {
     }
 }
 
+bool OutdoorScene::IsDaytime() const {
+    return timeOfDay > 0.3f && timeOfDay < 0.7f;
+}
+
 Color OutdoorScene::GetGrassColor() {
     float brightness = 1.0f;
     if (timeOfDay < 0.3f || timeOfDay > 0.7f) {
@@ -439,7 +461,7 @@ void OutdoorScene::DrawBuildingWithDetails(Building b) {
         for (int x = 0; x < windowsX; x++) {
             float wx = b.position.x + 15 + x * 30;
             float wy = b.position.y + 20 + y * 35;
-            Color windowColor = (timeOfDay > 0.3f && timeOfDay < 0.7f) ? Color{150, 200, 255, 200} : Color{255, 240, 150, 255};
+            Color windowColor = IsDaytime() ? Color{150, 200, 255, 200} : Color{255, 240, 150, 255};
             DrawRectangle(wx, wy, 18, 22, windowColor);
             DrawRectangleLinesEx({wx, wy, 18, 22}, 2, ColorBrightness(b.color, -0.5f));
             DrawLine(wx + 9, wy, wx + 9, wy + 22, ColorBrightness(b.color, -0.5f));
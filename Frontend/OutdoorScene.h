@@ -3,6 +3,7 @@
 
 #include "Scene.h"
 #include "ObjectTypes.h"
+#include "CachedLayer.h"
 #include <math.h>
 #include <stdlib.h>
 #include <time.h>
@@ -59,6 +60,12 @@ private:
 
     SceneType nextScene;
 
+    // Grass, roads, garden, buildings, houses and trees: only changes with
+    // the grass shade and day/night windows, so it's drawn into a texture
+    CachedLayer staticLayer;
+    Color layerGrass;
+    bool layerDaytime;
+
     // Helper functions
     void InitBuildings();
     void InitRoads();
@@ -77,6 +84,8 @@ private:
     void HandleBuildingClicks();
 
     // Draw functions
+    void RefreshStaticLayer();
+    void DrawStaticLayer();
     void DrawTiledBackground(Color baseColor, int width, int height);
     void DrawSimpleHorizontalRoad(Road r);
     void DrawSimpleVerticalRoad(Road r);
@@ -95,6 +104,7 @@ private:
     float Distance(Vector2 a, Vector2 b);
     Color GetSkyColor();
     Color GetGrassColor();
+    bool IsDaytime() const;
     int ClampValue(int value, int min, int max);
     Vector2 GetBuildingEntrance(Building b);
     
@@ -0,0 +1,119 @@
+#include "PlantSpriteCache.h"
+#include "PlantVisualStrategy.h"
+#include <algorithm>
+
+PlantSpriteCache& PlantSpriteCache::getInstance()
+{
+    static PlantSpriteCache instance;
+    return instance;
+}
+
+PlantSpriteCache::PlantSpriteCache()
+    : atlas(), plotSize(0.0f), typesBaked(0), cellWidth(0.0f), cellHeight(0.0f),
+      anchor{0.0f, 0.0f}, rowByType(PlantTypes::MAX_TYPES, -1)
+{
+}
+
+int PlantSpriteCache::stageFor(float growth)
+{
+    int stage = (int)(growth / 100.0f * (GROWTH_STAGES - 1) + 0.5f);
+    if (stage < 0)
+        return 0;
+    if (stage >= GROWTH_STAGES)
+        return GROWTH_STAGES - 1;
+    return stage;
+}
+
+void PlantSpriteCache::build(float size)
+{
+    if (isBuilt() && size == plotSize && typesBaked == PlantTypes::count())
+        return;
+    cleanup();
+
+    plotSize = size;
+    typesBaked = PlantTypes::count();
+
+    // One cell size fits the largest crop. The strategies draw past their
+    // nominal box (flower heads above the stem, pumpkin vines below the
+    // base), so leave room on every side.
+    std::vector<PlantTypeId> types;
+    float maxWidth = 0.0f;
+    float maxHeight = 0.0f;
+    for (int type = 0; type < typesBaked; type++)
+    {
+        const PlantDescriptor* crop = PlantTypes::describe((PlantTypeId)type);
+        if (crop == nullptr || PlantVisualFactory::getInstance().getVisual((PlantTypeId)type) == nullptr)
+            continue;
+        types.push_back((PlantTypeId)type);
+        maxWidth = std::max(maxWidth, size * crop->width);
+        maxHeight = std::max(maxHeight, size * crop->height);
+    }
+    cellWidth = maxWidth * 2.0f;
+    cellHeight = maxHeight * 2.0f;
+    anchor = Vector2{cellWidth * 0.5f, cellHeight * 0.7f};
+
+    int rows = (int)types.size();
+    if (rows == 0)
+        return;
+    atlas = LoadRenderTexture((int)(cellWidth * GROWTH_STAGES * 2), (int)(cellHeight * rows));
+    if (atlas.id == 0)
+        return;
+
+    BeginTextureMode(atlas);
+    ClearBackground(BLANK);
+    for (int row = 0; row < rows; row++)
+    {
+        const PlantDescriptor* crop = PlantTypes::describe(types[row]);
+        const PlantVisualStrategy* visual = PlantVisualFactory::getInstance().getVisual(types[row]);
+        rowByType[types[row]] = row;
+
+        for (int column = 0; column < GROWTH_STAGES * 2; column++)
+        {
+            bool dead = column >= GROWTH_STAGES;
+            float progress = (column % GROWTH_STAGES) / (float)(GROWTH_STAGES - 1);
+            // Same sizing as Plant::draw
+            float scale = 0.3f + 0.7f * progress;
+            visual->drawDetailed(column * cellWidth + anchor.x, row * cellHeight + anchor.y,
+                                 size * crop->width * scale, size * crop->height * scale, progress, dead);
+        }
+    }
+    EndTextureMode();
+}
+
+bool PlantSpriteCache::queue(PlantTypeId type, float growth, bool dead, float x, float y)
+{
+    if (!isBuilt() || type >= rowByType.size() || rowByType[type] < 0)
+        return false;
+
+    int column = stageFor(growth) + (dead ? GROWTH_STAGES : 0);
+    float cellX = column * cellWidth;
+    float cellY = rowByType[type] * cellHeight;
+
+    // Render textures are stored bottom-up: flip the source rectangle
+    Sprite sprite;
+    sprite.source = Rectangle{cellX, atlas.texture.height - cellY - cellHeight, cellWidth, -cellHeight};
+    sprite.position = Vector2{x - anchor.x, y - anchor.y};
+    pending.push_back(sprite);
+    return true;
+}
+
+void PlantSpriteCache::flush()
+{
+    for (const Sprite& sprite : pending)
+    {
+        DrawTextureRec(atlas.texture, sprite.source, sprite.position, WHITE);
+    }
+    pending.clear();
+}
+
+void PlantSpriteCache::cleanup()
+{
+    pending.clear();
+    if (atlas.id != 0)
+    {
+        UnloadRenderTexture(atlas);
+    }
+    atlas = RenderTexture2D();
+    for (int& row : rowByType)
+        row = -1;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "raylib.h"
+#include "../Backend/PlantTypes.h"
+#include <vector>
+
+// Every plant type pre-drawn into one RenderTexture atlas: a row per type,
+// GROWTH_STAGES live columns then the same stages dead. Drawing a plot is
+// then one textured quad instead of the strategy's dozens of shape calls,
+// and since every quad samples the same texture raylib batches a whole
+// greenhouse into a single draw call.
+class PlantSpriteCache
+{
+public:
+    static const int GROWTH_STAGES = 8;
+
+    static PlantSpriteCache& getInstance();
+
+    // Bakes the atlas for plots of this size, each crop at its full-grown
+    // size from its PlantDescriptor (the sizes Plant::draw takes). Needs the
+    // window; does nothing if already built for the same size and crops.
+    void build(float plotSize);
+    bool isBuilt() const { return atlas.id != 0; }
+
+    // Queues one plant at its plot anchor (bottom centre, as Plant::draw).
+    // growth is 0-100. False if the type has no sprite, so the caller can
+    // draw the plant itself.
+    bool queue(PlantTypeId type, float growth, bool dead, float x, float y);
+    // Draws everything queued since the last flush, back to back
+    void flush();
+
+    // Growth stage (column) a 0-100 growth value is shown with
+    static int stageFor(float growth);
+
+    // Unload the atlas; call before CloseWindow()
+    void cleanup();
+
+private:
+    PlantSpriteCache();
+    PlantSpriteCache(const PlantSpriteCache&) = delete;
+    PlantSpriteCache& operator=(const PlantSpriteCache&) = delete;
+
+    struct Sprite
+    {
+        Rectangle source;
+        Vector2 position;
+    };
+
+    RenderTexture2D atlas;
+    float plotSize;
+    int typesBaked;             // PlantTypes::count() when built
+    float cellWidth;
+    float cellHeight;
+    Vector2 anchor;             // where the plant's base sits inside a cell
+    std::vector<int> rowByType; // indexed by PlantTypeId, -1 if not baked
+    std::vector<Sprite> pending;
+};
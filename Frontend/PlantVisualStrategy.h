@@ -3,8 +3,17 @@
 
 #pragma once
 
+#ifdef TEMPLANTER_HEADLESS
+#include "../Backend/HeadlessRenderer.h"
+#else
 #include "raylib.h"
+#endif
+#include "../Backend/PlantTypes.h"
 #include <math.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 // --- General Constants ---
 #define PI 3.14159265358979323846f
@@ -22,18 +31,16 @@ inline Color PlantColorLerp(Color c1, Color c2, float t)
 }
 
 // --- Base Abstract Strategy Class ---
+// Flyweight: one shared instance per plant type (see PlantVisualFactory).
+// Strategies hold no per-plant state; size, growth and death come in with
+// each draw call, so any number of plants (and threads) can use one at once.
 class PlantVisualStrategy
 {
 protected:
-    float currentWidth;
-    float currentHeight;
-    float growthProgress; // 0.0 to 1.0 (from PlantState::getGrowth() / 100.0f)
-    bool isCurrentlyDead;
-
     // Helper for applying death filter
-    Color applyDeathFilter(Color baseColor) const
+    static Color applyDeathFilter(Color baseColor, bool dead)
     {
-        if (isCurrentlyDead)
+        if (dead)
         {
             // Fades color towards a dark, unhealthy brown/black
             return PlantColorLerp(baseColor, Color{50, 40, 30, 255}, 0.8f);
@@ -42,22 +49,18 @@ protected:
     }
 
 public:
-    PlantVisualStrategy(float width, float height) : currentWidth(width), currentHeight(height), growthProgress(0.0f), isCurrentlyDead(false) {}
+    PlantVisualStrategy() = default;
     virtual ~PlantVisualStrategy() = default;
 
-    void setGrowth(float progress) { growthProgress = fmaxf(0.0f, fminf(1.0f, progress)); }
-    void setDimensions(float width, float height)
-    {
-        currentWidth = width;
-        currentHeight = height;
-    }
-    void setDead(bool dead) { isCurrentlyDead = dead; }
+    PlantVisualStrategy(const PlantVisualStrategy&) = delete;
+    PlantVisualStrategy& operator=(const PlantVisualStrategy&) = delete;
 
-    // DYNAMIC VISUAL: Uses growth and death state (for in-plot rendering)
-    virtual void drawDetailed(float x, float y) = 0;
+    // DYNAMIC VISUAL: for in-plot rendering. width/height are the plant's
+    // current size, growth is 0.0 to 1.0 (PlantState::getGrowth() / 100.0f)
+    virtual void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const = 0;
 
     // STATIC VISUAL: Used for menus/icons, fixed size, fixed color (for clarity)
-    virtual void drawStatic(float x, float y) = 0;
+    virtual void drawStatic(float x, float y) const = 0;
 };
 
 // --- Concrete Visual Strategies ---
@@ -66,26 +69,24 @@ public:
 class LettuceVisualStrategy : public PlantVisualStrategy
 {
 public:
-    LettuceVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color color = applyDeathFilter(PlantColorLerp(DARKGREEN, LIME, growthProgress * 0.3f + 0.7f));
-        DrawCircle(x, y - currentHeight * 0.3f, currentWidth * 0.5f, color);
+        Color color = applyDeathFilter(PlantColorLerp(DARKGREEN, LIME, growth * 0.3f + 0.7f), dead);
+        DrawCircle(x, y - height * 0.3f, width * 0.5f, color);
 
-        if (growthProgress > 0.3f)
+        if (growth > 0.3f)
         {
-            float leafDensity = growthProgress * 8.0f;
+            float leafDensity = growth * 8.0f;
             for (int i = 0; i < (int)leafDensity; i++)
             {
                 float angle = (i / leafDensity) * 360.0f;
-                float leafX = x + cosf(angle * PI / 180.0f) * currentWidth * 0.35f;
-                float leafY = y - currentHeight * 0.2f + sinf(angle * PI / 180.0f) * currentHeight * 0.2f;
-                DrawCircle(leafX, leafY, currentWidth * 0.15f, color);
+                float leafX = x + cosf(angle * PI / 180.0f) * width * 0.35f;
+                float leafY = y - height * 0.2f + sinf(angle * PI / 180.0f) * height * 0.2f;
+                DrawCircle(leafX, leafY, width * 0.15f, color);
             }
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawCircle(x, y, STATIC_ICON_SIZE * 0.5f, DARKGREEN);
         DrawCircle(x, y, STATIC_ICON_SIZE * 0.3f, LIME);
@@ -96,30 +97,28 @@ public:
 class CarrotVisualStrategy : public PlantVisualStrategy
 {
 public:
-    CarrotVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color rootColor = applyDeathFilter(PlantColorLerp(ORANGE, Color{255, 150, 0, 255}, growthProgress));
-        float rootWidth = currentWidth * 0.6f;
-        DrawTriangle(Vector2{x - rootWidth / 2, y - currentHeight * 0.7f}, Vector2{x + rootWidth / 2, y - currentHeight * 0.7f}, Vector2{x, y}, rootColor);
+        Color rootColor = applyDeathFilter(PlantColorLerp(ORANGE, Color{255, 150, 0, 255}, growth), dead);
+        float rootWidth = width * 0.6f;
+        DrawTriangle(Vector2{x - rootWidth / 2, y - height * 0.7f}, Vector2{x + rootWidth / 2, y - height * 0.7f}, Vector2{x, y}, rootColor);
 
-        if (growthProgress > 0.2f)
+        if (growth > 0.2f)
         {
-            Color leafColor = applyDeathFilter(PlantColorLerp(DARKGREEN, LIME, growthProgress * 0.5f));
+            Color leafColor = applyDeathFilter(PlantColorLerp(DARKGREEN, LIME, growth * 0.5f), dead);
             for (int i = 0; i < 5; i++)
             {
                 float angle = (i / 5.0f) * 180.0f - 90.0f;
-                float leafLen = currentHeight * 0.4f * growthProgress;
-                float startX = x + cosf(angle * PI / 180.0f) * currentWidth * 0.2f;
-                float startY = y - currentHeight * 0.7f;
+                float leafLen = height * 0.4f * growth;
+                float startX = x + cosf(angle * PI / 180.0f) * width * 0.2f;
+                float startY = y - height * 0.7f;
                 float endX = startX + cosf(angle * PI / 180.0f) * leafLen;
                 float endY = startY + sinf(angle * PI / 180.0f) * leafLen;
                 DrawLineEx(Vector2{startX, startY}, Vector2{endX, endY}, 3.0f, leafColor);
             }
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawTriangle(Vector2{x - STATIC_ICON_SIZE * 0.3f, y + STATIC_ICON_SIZE * 0.5f}, Vector2{x + STATIC_ICON_SIZE * 0.3f, y + STATIC_ICON_SIZE * 0.5f}, Vector2{x, y - STATIC_ICON_SIZE * 0.5f}, ORANGE);
         DrawRectangle(x - 2, y - STATIC_ICON_SIZE * 0.5f, 4, 8, DARKGREEN);
@@ -130,41 +129,39 @@ public:
 class PotatoVisualStrategy : public PlantVisualStrategy
 {
 public:
-    PotatoVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color potatoColor = applyDeathFilter(PlantColorLerp(Color{139, 90, 43, 255}, Color{180, 120, 60, 255}, growthProgress));
-        DrawCircle(x, y, currentWidth * 0.5f, potatoColor);
+        Color potatoColor = applyDeathFilter(PlantColorLerp(Color{139, 90, 43, 255}, Color{180, 120, 60, 255}, growth), dead);
+        DrawCircle(x, y, width * 0.5f, potatoColor);
 
         // Bumpy texture
-        float bumpSize = currentWidth * 0.1f;
+        float bumpSize = width * 0.1f;
         for (int i = 0; i < 4; i++)
         {
             float angle = (i / 4.0f) * 360.0f;
-            float bumpX = x + cosf(angle * PI / 180.0f) * currentWidth * 0.35f;
-            float bumpY = y + sinf(angle * PI / 180.0f) * currentWidth * 0.3f;
+            float bumpX = x + cosf(angle * PI / 180.0f) * width * 0.35f;
+            float bumpY = y + sinf(angle * PI / 180.0f) * width * 0.3f;
             DrawCircle(bumpX, bumpY, bumpSize, Color{160, 110, 70, 255});
         }
 
         // Green sprouts on top
-        if (growthProgress > 0.25f)
+        if (growth > 0.25f)
         {
-            Color sproutColor = applyDeathFilter(PlantColorLerp(DARKGREEN, LIME, growthProgress * 0.6f));
-            int sproutCount = 2 + (int)(growthProgress * 3.0f);
+            Color sproutColor = applyDeathFilter(PlantColorLerp(DARKGREEN, LIME, growth * 0.6f), dead);
+            int sproutCount = 2 + (int)(growth * 3.0f);
             for (int i = 0; i < sproutCount; i++)
             {
                 float angle = (i / (float)sproutCount) * 180.0f;
-                float sproutLen = currentHeight * 0.8f * growthProgress;
-                float startX = x + cosf(angle * PI / 180.0f) * currentWidth * 0.2f;
-                float startY = y - currentWidth * 0.5f;
+                float sproutLen = height * 0.8f * growth;
+                float startX = x + cosf(angle * PI / 180.0f) * width * 0.2f;
+                float startY = y - width * 0.5f;
                 float endX = startX + cosf(angle * PI / 180.0f) * sproutLen;
                 float endY = startY - sproutLen;
                 DrawLineEx(Vector2{startX, startY}, Vector2{endX, endY}, 2.5f, sproutColor);
             }
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawCircle(x, y, STATIC_ICON_SIZE * 0.5f, BROWN);
         DrawCircle(x + STATIC_ICON_SIZE * 0.3f, y - STATIC_ICON_SIZE * 0.3f, 4, LIME);
@@ -175,41 +172,39 @@ public:
 class CucumberVisualStrategy : public PlantVisualStrategy
 {
 public:
-    CucumberVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color cucColor = applyDeathFilter(PlantColorLerp(DARKGREEN, LIME, growthProgress * 0.4f + 0.6f));
+        Color cucColor = applyDeathFilter(PlantColorLerp(DARKGREEN, LIME, growth * 0.4f + 0.6f), dead);
         DrawRectangleRounded(
-            Rectangle{x - currentWidth / 2, y - currentHeight, currentWidth, currentHeight}, // Corrected: Only 4 values
+            Rectangle{x - width / 2, y - height, width, height}, // Corrected: Only 4 values
             0.5f, 8, cucColor);
 
         // Bumpy texture
-        float bumpCount = 8.0f * growthProgress;
+        float bumpCount = 8.0f * growth;
         for (int i = 0; i < (int)bumpCount; i++)
         {
-            float yPos = y - currentHeight + (i / bumpCount) * currentHeight;
-            float offset = (i % 2) ? currentWidth * 0.3f : -currentWidth * 0.3f;
+            float yPos = y - height + (i / bumpCount) * height;
+            float offset = (i % 2) ? width * 0.3f : -width * 0.3f;
             DrawCircle(x + offset, yPos, 4.0f, Color{34, 139, 34, 255});
         }
 
         // Curling vine when mature
-        if (growthProgress > 0.4f)
+        if (growth > 0.4f)
         {
             Color vineColor = DARKGREEN;
-            float vineLen = currentHeight * 0.5f * growthProgress;
+            float vineLen = height * 0.5f * growth;
             for (float t = 0.0f; t < 1.0f; t += 0.05f)
             {
                 float angle = t * 720.0f * PI / 180.0f;
-                float vX1 = x + currentWidth / 2 + cosf(angle) * 15.0f;
-                float vY1 = y - currentHeight - t * vineLen;
-                float vX2 = x + currentWidth / 2 + cosf(angle + 0.1f) * 15.0f;
-                float vY2 = y - currentHeight - (t + 0.05f) * vineLen;
+                float vX1 = x + width / 2 + cosf(angle) * 15.0f;
+                float vY1 = y - height - t * vineLen;
+                float vX2 = x + width / 2 + cosf(angle + 0.1f) * 15.0f;
+                float vY2 = y - height - (t + 0.05f) * vineLen;
                 DrawLineEx(Vector2{vX1, vY1}, Vector2{vX2, vY2}, 2.0f, vineColor);
             }
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawRectangle(x - STATIC_ICON_SIZE * 0.15f, y - STATIC_ICON_SIZE * 0.5f, STATIC_ICON_SIZE * 0.3f, STATIC_ICON_SIZE, DARKGREEN);
         DrawCircle(x + STATIC_ICON_SIZE * 0.15f, y - STATIC_ICON_SIZE * 0.3f, 3, LIME);
@@ -220,38 +215,36 @@ public:
 class TomatoVisualStrategy : public PlantVisualStrategy
 {
 public:
-    TomatoVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color stemColor = applyDeathFilter(DARKGREEN);
-        Color fruitColor = applyDeathFilter(PlantColorLerp(ORANGE, RED, growthProgress * 0.7f + 0.3f));
+        Color stemColor = applyDeathFilter(DARKGREEN, dead);
+        Color fruitColor = applyDeathFilter(PlantColorLerp(ORANGE, RED, growth * 0.7f + 0.3f), dead);
 
-        DrawLineEx(Vector2{x, y}, Vector2{x, y - currentHeight}, 4.0f, stemColor);
+        DrawLineEx(Vector2{x, y}, Vector2{x, y - height}, 4.0f, stemColor);
 
-        float branchCount = 2.0f + growthProgress * 2.0f;
+        float branchCount = 2.0f + growth * 2.0f;
         for (int i = 0; i < (int)branchCount; i++)
         {
             float angle = (i / branchCount) * 180.0f - 90.0f + 30.0f;
-            float branchLen = currentHeight * 0.4f;
+            float branchLen = height * 0.4f;
             float branchX = x + cosf(angle * PI / 180.0f) * branchLen;
-            float branchY = y - currentHeight * 0.5f + sinf(angle * PI / 180.0f) * branchLen;
+            float branchY = y - height * 0.5f + sinf(angle * PI / 180.0f) * branchLen;
             DrawLineEx(Vector2{x}, Vector2{branchX, branchY}, 2.0f, stemColor);
 
-            if (growthProgress > 0.5f)
+            if (growth > 0.5f)
             {
-                DrawCircle(branchX, branchY, currentWidth * 0.25f, fruitColor);
+                DrawCircle(branchX, branchY, width * 0.25f, fruitColor);
                 DrawCircle(branchX + 5, branchY - 5, 2.0f, YELLOW);
             }
         }
 
-        if (growthProgress > 0.4f)
+        if (growth > 0.4f)
         {
-            DrawCircle(x, y - currentHeight * 0.3f, currentWidth * 0.35f, fruitColor);
-            DrawCircle(x + 7, y - currentHeight * 0.3f - 7, 3.0f, YELLOW);
+            DrawCircle(x, y - height * 0.3f, width * 0.35f, fruitColor);
+            DrawCircle(x + 7, y - height * 0.3f - 7, 3.0f, YELLOW);
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawCircle(x, y, STATIC_ICON_SIZE * 0.5f, DARKGREEN);
         DrawCircle(x, y - STATIC_ICON_SIZE * 0.2f, STATIC_ICON_SIZE * 0.3f, RED);
@@ -262,40 +255,38 @@ public:
 class PepperVisualStrategy : public PlantVisualStrategy
 {
 public:
-    PepperVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color stemColor = applyDeathFilter(DARKGREEN);
-        Color pepperColor = applyDeathFilter(PlantColorLerp(DARKGREEN, Color{255, 165, 0, 255}, growthProgress * 0.8f));
+        Color stemColor = applyDeathFilter(DARKGREEN, dead);
+        Color pepperColor = applyDeathFilter(PlantColorLerp(DARKGREEN, Color{255, 165, 0, 255}, growth * 0.8f), dead);
 
-        DrawLineEx(Vector2{x, y}, Vector2{x, y - currentHeight * 0.3f}, 3.0f, stemColor);
+        DrawLineEx(Vector2{x, y}, Vector2{x, y - height * 0.3f}, 3.0f, stemColor);
 
-        float pepperY = y - currentHeight * 0.5f;
+        float pepperY = y - height * 0.5f;
         DrawRectangleRounded(
-            Rectangle{x - currentWidth / 2, pepperY - currentHeight * 0.5f, currentWidth, currentHeight * 0.6f}, // Corrected
+            Rectangle{x - width / 2, pepperY - height * 0.5f, width, height * 0.6f}, // Corrected
             0.4f, 8, pepperColor                                                                                 // The '0.4f' is the roundness factor
         );
 
-        if (growthProgress > 0.3f)
+        if (growth > 0.3f)
         {
             float ridgeCount = 4.0f;
             for (int i = 0; i < (int)ridgeCount; i++)
             {
-                float ridgeX = x - currentWidth * 0.35f + (i / ridgeCount) * currentWidth * 0.7f;
-                DrawLineEx(Vector2{ridgeX, pepperY - currentHeight * 0.5f}, Vector2{ridgeX, pepperY + currentHeight * 0.1f}, 1.5f, Color{200, 140, 70, 255});
+                float ridgeX = x - width * 0.35f + (i / ridgeCount) * width * 0.7f;
+                DrawLineEx(Vector2{ridgeX, pepperY - height * 0.5f}, Vector2{ridgeX, pepperY + height * 0.1f}, 1.5f, Color{200, 140, 70, 255});
             }
         }
 
         for (int i = 0; i < 4; i++)
         {
             float angle = (i / 4.0f) * 360.0f;
-            float tipX = x + cosf(angle * PI / 180.0f) * currentWidth * 0.2f;
-            float tipY = pepperY - currentHeight * 0.5f - 5;
+            float tipX = x + cosf(angle * PI / 180.0f) * width * 0.2f;
+            float tipY = pepperY - height * 0.5f - 5;
             DrawCircle(tipX, tipY, 3.0f, stemColor);
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawRectangle(x - STATIC_ICON_SIZE * 0.25f, y - STATIC_ICON_SIZE * 0.5f, STATIC_ICON_SIZE * 0.5f, STATIC_ICON_SIZE, ORANGE);
         DrawCircle(x, y - STATIC_ICON_SIZE * 0.5f, 4, DARKGREEN);
@@ -306,58 +297,56 @@ public:
 class SunflowerVisualStrategy : public PlantVisualStrategy
 {
 public:
-    SunflowerVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color stemColor = applyDeathFilter(DARKGREEN);
+        Color stemColor = applyDeathFilter(DARKGREEN, dead);
         Color petalColor = YELLOW;
-        Color centerColor = applyDeathFilter(Color{184, 134, 11, 255});
+        Color centerColor = applyDeathFilter(Color{184, 134, 11, 255}, dead);
 
-        DrawLineEx(Vector2{x, y}, Vector2{x, y - currentHeight}, 5.0f, stemColor);
+        DrawLineEx(Vector2{x, y}, Vector2{x, y - height}, 5.0f, stemColor);
 
-        if (growthProgress > 0.2f)
+        if (growth > 0.2f)
         {
-            int leafCount = 3 + (int)(growthProgress * 2.0f);
+            int leafCount = 3 + (int)(growth * 2.0f);
             for (int i = 0; i < leafCount; i++)
             {
-                float leafY = y - (i / (float)leafCount) * currentHeight * 0.8f;
+                float leafY = y - (i / (float)leafCount) * height * 0.8f;
                 float angle = (i % 2) ? 45.0f : -45.0f;
-                float leafLen = currentWidth * 0.4f;
+                float leafLen = width * 0.4f;
                 float leafX = x + cosf(angle * PI / 180.0f) * leafLen;
                 float leafEndY = leafY + sinf(angle * PI / 180.0f) * leafLen;
                 DrawLineEx(Vector2{x, leafY}, Vector2{leafX, leafEndY}, 3.0f, stemColor);
             }
         }
 
-        if (growthProgress > 0.5f)
+        if (growth > 0.5f)
         {
-            float flowerRadius = currentWidth * 0.5f * growthProgress;
-            int petalCount = 16 + (int)(growthProgress * 8.0f);
+            float flowerRadius = width * 0.5f * growth;
+            int petalCount = 16 + (int)(growth * 8.0f);
             for (int i = 0; i < petalCount; i++)
             {
                 float angle = (i / (float)petalCount) * 360.0f;
                 float startX = x + cosf(angle * PI / 180.0f) * flowerRadius * 0.3f;
-                float startY = y - currentHeight + sinf(angle * PI / 180.0f) * flowerRadius * 0.3f;
+                float startY = y - height + sinf(angle * PI / 180.0f) * flowerRadius * 0.3f;
                 float endX = x + cosf(angle * PI / 180.0f) * flowerRadius;
-                float endY = y - currentHeight + sinf(angle * PI / 180.0f) * flowerRadius;
+                float endY = y - height + sinf(angle * PI / 180.0f) * flowerRadius;
                 DrawTriangle(Vector2{startX - 3, startY}, Vector2{startX + 3, startY}, Vector2{endX, endY}, petalColor);
             }
 
-            DrawCircle(x, y - currentHeight, flowerRadius * 0.35f, centerColor);
+            DrawCircle(x, y - height, flowerRadius * 0.35f, centerColor);
 
-            int seedCount = 30 * growthProgress;
+            int seedCount = 30 * growth;
             for (int i = 0; i < (int)seedCount; i++)
             {
                 float seedAngle = (i / (float)seedCount) * 360.0f;
                 float seedDist = 5.0f + (i % 3) * 3.0f;
                 float seedX = x + cosf(seedAngle * PI / 180.0f) * seedDist;
-                float seedY = y - currentHeight + sinf(seedAngle * PI / 180.0f) * seedDist;
+                float seedY = y - height + sinf(seedAngle * PI / 180.0f) * seedDist;
                 DrawCircle(seedX, seedY, 1.5f, Color{139, 90, 43, 255});
             }
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawCircle(x, y - STATIC_ICON_SIZE * 0.3f, STATIC_ICON_SIZE * 0.3f, YELLOW);
         DrawCircle(x, y - STATIC_ICON_SIZE * 0.3f, STATIC_ICON_SIZE * 0.15f, Color{184, 134, 11, 255});
@@ -369,38 +358,36 @@ public:
 class CornVisualStrategy : public PlantVisualStrategy
 {
 public:
-    CornVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color stalkColor = applyDeathFilter(DARKGREEN);
-        Color leafColor = applyDeathFilter(LIME);
-        Color earColor = applyDeathFilter(YELLOW);
+        Color stalkColor = applyDeathFilter(DARKGREEN, dead);
+        Color leafColor = applyDeathFilter(LIME, dead);
+        Color earColor = applyDeathFilter(YELLOW, dead);
 
         // Main stalk
-        DrawLineEx(Vector2{x, y}, Vector2{x, y - currentHeight}, 6.0f, stalkColor);
+        DrawLineEx(Vector2{x, y}, Vector2{x, y - height}, 6.0f, stalkColor);
 
         // Leaves along stalk (Restored original logic)
-        int leafCount = 4 + (int)(growthProgress * 4.0f);
+        int leafCount = 4 + (int)(growth * 4.0f);
         for (int i = 0; i < leafCount; i++)
         {
-            float leafY = y - (i / (float)leafCount) * currentHeight * 0.85f;
+            float leafY = y - (i / (float)leafCount) * height * 0.85f;
             float angle = (i % 2) ? 40.0f : -40.0f;
-            float leafLen = currentWidth * 0.6f;
+            float leafLen = width * 0.6f;
             
             // --- RESTORED LEAF BLADE DRAWING ---
             DrawRectangleRounded(
-                Rectangle{x, leafY, leafLen * 0.7f, currentWidth * 0.4f},
+                Rectangle{x, leafY, leafLen * 0.7f, width * 0.4f},
                 0.3f, 4, leafColor
             );
         }
 
         // Corn ear (cob with kernels) - Only visible when grown
-        if (growthProgress > 0.5f)
+        if (growth > 0.5f)
         {
             // --- earX and earY are defined here, ensuring scope is correct ---
-            float earY = y - currentHeight * 0.4f;
-            float earX = x + currentWidth * 0.4f;
+            float earY = y - height * 0.4f;
+            float earX = x + width * 0.4f;
 
             // Cob (DrawRectangleRounded is now correct)
             DrawRectangleRounded(
@@ -427,7 +414,7 @@ public:
             }
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawRectangle(x - 3, y - STATIC_ICON_SIZE * 0.5f, 6, STATIC_ICON_SIZE, DARKGREEN);
         DrawRectangle(x + 5, y - 5, 4, 10, YELLOW);
@@ -437,32 +424,30 @@ public:
 class StrawberryVisualStrategy : public PlantVisualStrategy
 {
 public:
-    StrawberryVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color leafColor = applyDeathFilter(DARKGREEN);
-        Color fruitColor = applyDeathFilter(PlantColorLerp(ORANGE, RED, growthProgress * 0.8f + 0.2f));
+        Color leafColor = applyDeathFilter(DARKGREEN, dead);
+        Color fruitColor = applyDeathFilter(PlantColorLerp(ORANGE, RED, growth * 0.8f + 0.2f), dead);
 
-        int leafCount = 6 + (int)(growthProgress * 3.0f);
+        int leafCount = 6 + (int)(growth * 3.0f);
         for (int i = 0; i < leafCount; i++)
         {
             float angle = (i / (float)leafCount) * 360.0f;
-            float leafLen = currentHeight * 0.4f * growthProgress;
+            float leafLen = height * 0.4f * growth;
             float endX = x + cosf(angle * PI / 180.0f) * leafLen;
             float endY = y - sinf(angle * PI / 180.0f) * leafLen;
             DrawLineEx(Vector2{x, y}, Vector2{endX, endY}, 3.0f, leafColor);
         }
 
-        if (growthProgress > 0.4f)
+        if (growth > 0.4f)
         {
-            int berryCount = 1 + (int)(growthProgress * 2.0f);
+            int berryCount = 1 + (int)(growth * 2.0f);
             for (int i = 0; i < berryCount; i++)
             {
                 float angle = (i / (float)berryCount) * 360.0f - 90.0f;
-                float berryDist = currentWidth * 0.3f;
+                float berryDist = width * 0.3f;
                 float berryX = x + cosf(angle * PI / 180.0f) * berryDist;
-                float berryY = y - currentHeight * 0.2f + sinf(angle * PI / 180.0f) * berryDist;
+                float berryY = y - height * 0.2f + sinf(angle * PI / 180.0f) * berryDist;
 
                 DrawCircle(berryX - 5, berryY - 3, 6.0f, fruitColor);
                 DrawCircle(berryX + 5, berryY - 3, 6.0f, fruitColor);
@@ -474,7 +459,7 @@ public:
             }
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawCircle(x, y, STATIC_ICON_SIZE * 0.5f, DARKGREEN);
         DrawCircle(x, y + STATIC_ICON_SIZE * 0.2f, STATIC_ICON_SIZE * 0.3f, RED);
@@ -485,39 +470,37 @@ public:
 class PumpkinVisualStrategy : public PlantVisualStrategy
 {
 public:
-    PumpkinVisualStrategy(float width, float height) : PlantVisualStrategy(width, height) {}
-
-    void drawDetailed(float x, float y) override
+    void drawDetailed(float x, float y, float width, float height, float growth, bool dead) const override
     {
-        Color pumpkinColor = applyDeathFilter(PlantColorLerp(ORANGE, Color{255, 100, 0, 255}, growthProgress * 0.5f));
-        Color vineColor = applyDeathFilter(DARKGREEN);
-        Color leafColor = applyDeathFilter(LIME);
+        Color pumpkinColor = applyDeathFilter(PlantColorLerp(ORANGE, Color{255, 100, 0, 255}, growth * 0.5f), dead);
+        Color vineColor = applyDeathFilter(DARKGREEN, dead);
+        Color leafColor = applyDeathFilter(LIME, dead);
 
-        float pumpkinRadius = currentWidth * 0.5f;
+        float pumpkinRadius = width * 0.5f;
 
-        int ridgeCount = 8 + (int)(growthProgress * 4.0f);
+        int ridgeCount = 8 + (int)(growth * 4.0f);
         for (int i = 0; i < ridgeCount; i++)
         {
             float angle = (i / (float)ridgeCount) * 360.0f;
             float startX = x + cosf(angle * PI / 180.0f) * pumpkinRadius * 0.7f;
-            float startY = y - currentHeight * 0.3f + sinf(angle * PI / 180.0f) * pumpkinRadius * 0.7f;
+            float startY = y - height * 0.3f + sinf(angle * PI / 180.0f) * pumpkinRadius * 0.7f;
             float endX = x + cosf(angle * PI / 180.0f) * pumpkinRadius;
-            float endY = y - currentHeight * 0.3f + sinf(angle * PI / 180.0f) * pumpkinRadius;
+            float endY = y - height * 0.3f + sinf(angle * PI / 180.0f) * pumpkinRadius;
             DrawLineEx(Vector2{startX, startY}, Vector2{endX, endY}, 2.0f, Color{200, 80, 0, 255});
         }
 
-        DrawCircle(x, y - currentHeight * 0.3f, pumpkinRadius * 0.9f, pumpkinColor);
-        DrawCircle(x - pumpkinRadius * 0.4f, y - currentHeight * 0.3f, pumpkinRadius * 0.8f, pumpkinColor);
-        DrawCircle(x + pumpkinRadius * 0.4f, y - currentHeight * 0.3f, pumpkinRadius * 0.8f, pumpkinColor);
+        DrawCircle(x, y - height * 0.3f, pumpkinRadius * 0.9f, pumpkinColor);
+        DrawCircle(x - pumpkinRadius * 0.4f, y - height * 0.3f, pumpkinRadius * 0.8f, pumpkinColor);
+        DrawCircle(x + pumpkinRadius * 0.4f, y - height * 0.3f, pumpkinRadius * 0.8f, pumpkinColor);
 
-        float stemLen = currentHeight * 0.4f;
-        DrawLineEx(Vector2{x, y - currentHeight * 0.3f - pumpkinRadius}, Vector2{x, y - currentHeight * 0.3f - pumpkinRadius - stemLen}, 5.0f, vineColor);
+        float stemLen = height * 0.4f;
+        DrawLineEx(Vector2{x, y - height * 0.3f - pumpkinRadius}, Vector2{x, y - height * 0.3f - pumpkinRadius - stemLen}, 5.0f, vineColor);
 
-        if (growthProgress > 0.3f)
+        if (growth > 0.3f)
         {
-            float vineLength = currentWidth * growthProgress;
+            float vineLength = width * growth;
             float vineStartX = x + pumpkinRadius * 0.5f;
-            float vineStartY = y - currentHeight * 0.3f;
+            float vineStartY = y - height * 0.3f;
 
             for (float t = 0.0f; t < 1.0f; t += 0.05f)
             {
@@ -530,11 +513,65 @@ public:
             }
         }
     }
-    void drawStatic(float x, float y) override
+    void drawStatic(float x, float y) const override
     {
         DrawCircle(x, y, STATIC_ICON_SIZE * 0.5f, ORANGE);
         DrawRectangle(x - 2, y - STATIC_ICON_SIZE * 0.6f, 4, 8, DARKGREEN);
     }
 };
 
+// Singleton factory that hands out the shared flyweight strategy for each
+// plant type. Every strategy is built up front, so lookups never write and
+// can be done from any thread.
+class PlantVisualFactory
+{
+public:
+    static PlantVisualFactory& getInstance()
+    {
+        static PlantVisualFactory instance;
+        return instance;
+    }
+
+    // nullptr for a type with no visual
+    const PlantVisualStrategy* getVisual(const std::string& plantType) const
+    {
+        return getVisual(PlantTypes::find(plantType));
+    }
+
+    // Crops from the registry may borrow another type's look
+    const PlantVisualStrategy* getVisual(PlantTypeId type) const
+    {
+        const PlantDescriptor* descriptor = PlantTypes::describe(type);
+        PlantTypeId look = descriptor ? descriptor->look : type;
+        return look < byType.size() ? byType[look] : nullptr;
+    }
+
+    size_t getVisualCount() const { return visuals.size(); }
+
+    PlantVisualFactory(const PlantVisualFactory&) = delete;
+    PlantVisualFactory& operator=(const PlantVisualFactory&) = delete;
+
+private:
+    PlantVisualFactory()
+    {
+        visuals["Lettuce"].reset(new LettuceVisualStrategy());
+        visuals["Carrot"].reset(new CarrotVisualStrategy());
+        visuals["Potato"].reset(new PotatoVisualStrategy());
+        visuals["Cucumber"].reset(new CucumberVisualStrategy());
+        visuals["Tomato"].reset(new TomatoVisualStrategy());
+        visuals["Pepper"].reset(new PepperVisualStrategy());
+        visuals["Sunflower"].reset(new SunflowerVisualStrategy());
+        visuals["Corn"].reset(new CornVisualStrategy());
+        visuals["Strawberry"].reset(new StrawberryVisualStrategy());
+        visuals["Pumpkin"].reset(new PumpkinVisualStrategy());
+
+        byType.resize(PlantTypes::BUILT_IN_COUNT, nullptr);
+        for (const auto& visual : visuals)
+            byType[PlantTypes::builtIn(visual.first)] = visual.second.get();
+    }
+
+    std::unordered_map<std::string, std::unique_ptr<const PlantVisualStrategy>> visuals;
+    std::vector<const PlantVisualStrategy*> byType;   // indexed by PlantTypeId
+};
+
 #endif // PLANTVISUALSTRATEGY_H
\ No newline at end of file
@@ -55,14 +55,19 @@ void SceneManager::HandleInput() {
         scenes[currentScene]->Init(); 
     }
     
-    // GLOBAL UI INPUT (Save/Load) ---
+    // GLOBAL UI INPUT (Save/Load/Sleep) ---
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
         Vector2 mousePos = GetMousePosition();
         float menuX = SCREEN_WIDTH - MENU_WIDTH;
         Rectangle saveBtn = {menuX + 10, 225.0f, MENU_WIDTH - 20, 30};
         Rectangle loadBtn = {menuX + 10, 265.0f, MENU_WIDTH - 20, 30};
+        Rectangle sleepBtn = {menuX + MENU_WIDTH - 100, 20.0f, 90, 25};
+        SimulationEngine &simulation = Game::getInstance()->getSimulation();
 
-        if (CheckCollisionPointRec(mousePos, saveBtn)) {
+        if (simulation.isNight() && CheckCollisionPointRec(mousePos, sleepBtn)) {
+            // The night passes in closed form instead of at 10x speed
+            simulation.sleepUntilMorning();
+        } else if (CheckCollisionPointRec(mousePos, saveBtn)) {
             Game::getInstance()->saveGame(); 
         } else if (CheckCollisionPointRec(mousePos, loadBtn)) {
             Game::getInstance()->loadGame();
@@ -8,25 +8,17 @@
 
 struct Slot
     {
-        const InventorySlot *slot;
+        InventorySlot slot;   // copy of the stack, refreshed by InventoryUI::update
         Rectangle rect;
         bool selected = false;
         std::string quantity;
         // Image icon;
 
-        Slot(const InventorySlot *slotIn, Rectangle rectIn)
+        Slot(const InventorySlot &slotIn, Rectangle rectIn)
         {
             slot = slotIn;
             rect = rectIn;
-
-            if (slotIn != nullptr)
-            {
-                quantity = std::to_string(slotIn->getSize());
-            }
-            else
-            {
-                quantity = "0";
-            }
+            quantity = std::to_string(slotIn.getSize());
         }
 
         bool isClicked(Vector2 mousePos) const
@@ -158,11 +158,11 @@ void StoreScene::HandleInput()
                 int selectedSlot = player->getInventoryUI()->getSelectedSlotIndex();
                 if (selectedSlot != -1)
                 {
-                    const InventorySlot *slot = player->getInventory()->getSlot(selectedSlot);
+                    const InventorySlot slot = player->getInventory()->getSlot(selectedSlot);
 
-                    if (slot && !slot->isEmpty())
+                    if (!slot.isEmpty())
                     {
-                        std::string plantType = slot->getPlantType();
+                        std::string plantType = slot.getPlantType();
 
                         if (customerManager->serveCustomer(clickedCustomer, plantType))
                         {
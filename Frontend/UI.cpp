@@ -20,6 +20,13 @@ void DrawGlobalMenu() {
         
         DrawText(TextFormat("DAY: %d", player->getDay()), menuX + 10, clockY, 20, RAYWHITE);
         DrawText(player->getTimeString().c_str(), menuX + 10, clockY + 30, 30, YELLOW);
+
+        // Sleep Button: only at night, skips straight to the morning
+        if (game->getSimulation().isNight()) {
+            Rectangle sleepBtn = {menuX + MENU_WIDTH - 100, (float)clockY, 90, 25};
+            DrawRectangleRec(sleepBtn, DARKBLUE);
+            DrawText("SLEEP", sleepBtn.x + (sleepBtn.width - MeasureText("SLEEP", 20))/2, sleepBtn.y + 3, 20, WHITE);
+        }
         
         
         int statsY = 95;
@@ -43,9 +50,18 @@ void DrawGlobalMenu() {
         Rectangle saveBtn = {menuX + 10, (float)buttonY, MENU_WIDTH - 20, 30};
         Rectangle loadBtn = {menuX + 10, (float)buttonY + 40, MENU_WIDTH - 20, 30};
         
-        // Draw Save Button
-        DrawRectangleRec(saveBtn, DARKGREEN);
-        DrawText("SAVE GAME", saveBtn.x + (saveBtn.width - MeasureText("SAVE GAME", 20))/2, saveBtn.y + 5, 20, WHITE);
+        // Draw Save Button (the write happens in the background, so show how it went)
+        const char* saveLabel = "SAVE GAME";
+        Color saveColor = DARKGREEN;
+        switch (Game::getInstance()->getSaveStatus())
+        {
+        case SaveStatus::Saving: saveLabel = "SAVING..."; saveColor = DARKGRAY; break;
+        case SaveStatus::Saved:  saveLabel = "SAVED"; break;
+        case SaveStatus::Failed: saveLabel = "SAVE FAILED"; saveColor = RED; break;
+        default: break;
+        }
+        DrawRectangleRec(saveBtn, saveColor);
+        DrawText(saveLabel, saveBtn.x + (saveBtn.width - MeasureText(saveLabel, 20))/2, saveBtn.y + 5, 20, WHITE);
         
         // Draw Load Button
         DrawRectangleRec(loadBtn, MAROON);
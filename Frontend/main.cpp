@@ -2,7 +2,9 @@
 #include "SceneManager.h" 
 #include "../Backend/Game.h"
 #include "../Backend/Player.h" 
+#include "../Backend/PlantTypes.h"
 #include "UI.h"
+#include "PlantSpriteCache.h"
 #include <stdlib.h>
 #include <time.h>
 #include <iostream>
@@ -18,6 +20,9 @@ int main(void) {
     SetTargetFPS(60);
     srand((unsigned int)time(NULL));
 
+    // Extra or adjusted crops, if the file is there
+    PlantTypes::loadFile("plants.txt");
+
     Game::getInstance(); 
     Game::getInstance()->getPlayer().addMoney(10000000000);
     
@@ -33,7 +38,8 @@ int main(void) {
 
         float dt = GetFrameTime();
         
-        Game::getInstance()->getPlayer().UpdateGameTime(dt); 
+        Game::getInstance()->getSimulation().update(dt); 
+        Game::getInstance()->autosaveIfDue();
         
         manager.Update(dt);
         manager.HandleInput();
@@ -44,6 +50,7 @@ int main(void) {
         manager.Draw();
     }
 
+    PlantSpriteCache::getInstance().cleanup();
     CloseWindow();
     return 0;
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include <vector>
 #include <thread>
 #include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <cstdio>
 
 // Backend includes
 #include "../Backend/Game.h"
@@ -13,8 +16,11 @@
 #include "../Backend/PlantFactory.h"
 #include "../Backend/PlantState.h"
 #include "../Backend/Greenhouse.h"
+#include "../Backend/PlantStore.h"
+#include "../Backend/TimerWheel.h"
 #include "../Backend/Inventory.h"
 #include "../Backend/Worker.h"
+#include "../Backend/WorkerPool.h"
 #include "../Backend/Command.h"
 #include "../Backend/Customer.h"
 #include "../Backend/CustomerFactory.h"
@@ -24,6 +30,8 @@
 #include "../Backend/Memento.h"
 #include "../Backend/Serializer.h"
 #include "../Backend/GrowthCycle.h"
+#include "../Backend/SimulationEngine.h"
+#include "../Backend/Logger.h"
 
 // Forward declaration for cleanup
 //extern void cleanupPlantCatalog();
@@ -102,6 +110,43 @@ TEST_CASE("PlantState - Growth Application") {
     }
 }
 
+TEST_CASE("PlantState - Stage Transitions") {
+    SUBCASE("Seed sprouts at the threshold") {
+        PlantState state(25.0f, 100.0f, 100.0f);
+        state.tick();
+        CHECK(state.getStage() == PlantStage::Growing);
+        CHECK(state.getWater() == 99.0f);
+    }
+
+    SUBCASE("Growing ripens at full growth") {
+        GrowingState state(100.0f, 100.0f, 100.0f);
+        state.tick();
+        CHECK(state.isRipe());
+        CHECK(state.getState() == "Ripe");
+    }
+
+    SUBCASE("Running dry kills the plant") {
+        GrowingState state(50.0f, 1.5f, 100.0f);
+        state.tick();
+        CHECK(state.isDead());
+        CHECK(state.getGrowth() == 50.0f);
+    }
+
+    SUBCASE("Dead plants only decay") {
+        DeadState state(10.0f, 50.0f, 50.0f);
+        state.tick();
+        CHECK(state.isDead());
+        CHECK(state.getGrowth() == 9.5f);
+        CHECK(state.getWater() == 50.0f);
+    }
+
+    SUBCASE("Rules table") {
+        CHECK(PlantState::nextStage(PlantStage::Seed, 10.0f, 50.0f, 50.0f) == PlantStage::Seed);
+        CHECK(PlantState::nextStage(PlantStage::Ripe, 151.0f, 50.0f, 50.0f) == PlantStage::Dead);
+        CHECK(PlantState::stageFromName(PlantState::stageName(PlantStage::Growing)) == PlantStage::Growing);
+    }
+}
+
 // =============================================================================
 // PLANT TESTS
 // =============================================================================
@@ -187,14 +232,40 @@ TEST_CASE("Plant - Death from Neglect") {
     delete plant;
 }
 
+TEST_CASE("Plant - Shared Visuals") {
+    PlantVisualFactory &visuals = PlantVisualFactory::getInstance();
+
+    SUBCASE("One strategy per plant type") {
+        CHECK(visuals.getVisualCount() == 10);
+        CHECK(visuals.getVisual("Lettuce") != nullptr);
+        CHECK(visuals.getVisual("Lettuce") == visuals.getVisual("Lettuce"));
+        CHECK(visuals.getVisual("Lettuce") != visuals.getVisual("Tomato"));
+        CHECK(visuals.getVisual("Weed") == nullptr);
+    }
+
+    SUBCASE("Plants share it and don't own it") {
+        LettuceFactory factory;
+        Plant *a = factory.produce();
+        Plant *b = factory.produce();
+        a->draw(0.0f, 0.0f, 20.0f, 15.0f);
+        b->draw(0.0f, 0.0f, 20.0f, 15.0f);
+        delete a;
+        delete b;
+        // Still usable once every plant that drew with it is gone
+        Plant *c = factory.produce();
+        c->draw(0.0f, 0.0f, 20.0f, 15.0f);
+        delete c;
+        CHECK(visuals.getVisual("Lettuce") != nullptr);
+    }
+}
+
 // =============================================================================
 // GROWTHCYCLE TESTS
 // =============================================================================
 
 TEST_CASE("GrowthCycle - Normal") {
     Plant *plant = new Lettuce(nullptr);
-    NormalGrowthCycle *normalCycle = new NormalGrowthCycle();
-    plant->setGrowthCycle(normalCycle);
+    plant->setGrowthCycle(NormalGrowthCycle{});
 
     float growthBefore = plant->getGrowth();
     plant->tick();
@@ -208,8 +279,7 @@ TEST_CASE("GrowthCycle - Boosted") {
     Plant *plant1 = new Lettuce(nullptr);
     Plant *plant2 = new Lettuce(nullptr);
 
-    BoostedGrowthCycle *boostedCycle = new BoostedGrowthCycle();
-    plant2->setGrowthCycle(boostedCycle);
+    plant2->setGrowthCycle(BoostedGrowthCycle{});
 
     for (int i = 0; i < 5; i++) {
         plant1->tick();
@@ -217,11 +287,41 @@ TEST_CASE("GrowthCycle - Boosted") {
     }
 
     CHECK(plant2->getGrowth() > plant1->getGrowth());
+    CHECK(plant2->getGrowthPerTick() == doctest::Approx(2.0f * plant1->getGrowthPerTick()));
 
     delete plant1;
     delete plant2;
 }
 
+TEST_CASE("GrowthCycle - Modifiers") {
+    Plant *plant = new Tomato(nullptr);
+    const float base = plant->getGrowthPerTick();
+
+    // Everything folds into one multiplier, worked out when the cycle is set
+    GrowthCycle cycle = GrowthCycle(BoostedGrowthCycle{})
+                            .with(Season::Summer)
+                            .with(Weather::Rain)
+                            .with(FertilizerQuality::Premium);
+    CHECK(cycle.getMultiplier() == doctest::Approx(2.0f * 1.25f * 1.1f * 1.5f));
+    plant->setGrowthCycle(cycle);
+    CHECK(plant->getGrowthPerTick() == doctest::Approx(base * cycle.getMultiplier()));
+    CHECK(plant->getGrowthCycle().getSeason() == Season::Summer);
+
+    SUBCASE("Planted plants pick up a new cycle") {
+        Inventory *inv = new Inventory(10);
+        Greenhouse *gh = new Greenhouse(inv);
+        Plant *planted = new Tomato(nullptr);
+        gh->addPlant(planted, 0);
+        planted->setGrowthCycle(GrowthCycle().with(Season::Winter));
+        gh->tickAllPlants();
+        CHECK(planted->getGrowth() == doctest::Approx(base * 0.5f));
+        delete gh;
+        delete inv;
+    }
+
+    delete plant;
+}
+
 // =============================================================================
 // INVENTORY TESTS
 // =============================================================================
@@ -292,6 +392,246 @@ TEST_CASE("Inventory - Full Check") {
     delete inv;
 }
 
+TEST_CASE("Inventory - Type Index") {
+    Inventory *inv = new Inventory(4);
+
+    SUBCASE("Interned type ids") {
+        Plant *a = new Lettuce(nullptr);
+        Plant *b = new Lettuce(nullptr);
+        Plant *c = new Tomato(nullptr);
+        CHECK(a->getTypeId() == b->getTypeId());
+        CHECK(a->getTypeId() != c->getTypeId());
+        CHECK(PlantTypes::find("Lettuce") == a->getTypeId());
+        CHECK(PlantTypes::name(c->getTypeId()) == "Tomato");
+        CHECK(PlantTypes::find("NoSuchPlant") == PlantTypes::NONE);
+        delete a;
+        delete b;
+        delete c;
+    }
+
+    SUBCASE("Counts follow adds, removes and swaps") {
+        for (int i = 0; i < 70; i++)
+            inv->add(new Tomato(nullptr));
+        inv->add(new Lettuce(nullptr));
+
+        // First stack fills up, the overflow starts a second one
+        CHECK(inv->getSlot(0).getSize() == 64);
+        CHECK(inv->getSlot(1).getSize() == 6);
+        CHECK(inv->getSlot(2).getPlantType() == "Lettuce");
+        CHECK(inv->getPlantCount("Tomato") == 70);
+        CHECK(inv->getPlantCount("Lettuce") == 1);
+        CHECK(inv->getPlantCount("NoSuchPlant") == 0);
+
+        // Moving stacks around keeps the counts and where new plants go
+        inv->swapSlots(1, 3);
+        inv->add(new Tomato(nullptr));
+        CHECK(inv->getSlot(3).getSize() == 7);
+        CHECK(inv->getPlantCount("Tomato") == 71);
+
+        delete inv->removeItem("Tomato");
+        CHECK(inv->getSlot(0).getSize() == 63);
+        CHECK(inv->getPlantCount("Tomato") == 70);
+
+        // The freed room is reused before the later stack
+        inv->add(new Tomato(nullptr));
+        CHECK(inv->getSlot(0).getSize() == 64);
+
+        CHECK(inv->removeStack(0));
+        CHECK(inv->getPlantCount("Tomato") == 7);
+        CHECK(inv->getPlantCount("Lettuce") == 1);
+
+        inv->clearSlot(1);
+        CHECK(inv->getPlantCount("Lettuce") == 0);
+        delete inv->removeItem("Lettuce");
+        CHECK(inv->removeItem("Lettuce") == nullptr);
+    }
+
+    SUBCASE("Index stays whole with adds and removes on two threads") {
+        Inventory *shared = new Inventory(64);
+        const int perType = 1500;
+        std::thread harvester([shared]() {
+            for (int i = 0; i < perType; i++) {
+                shared->add(new Tomato(nullptr));
+                shared->add(PlantTypes::LETTUCE, 1);
+            }
+        });
+
+        int sold = 0;
+        while (sold < perType) {
+            Plant *plant = shared->removeItem(sold % 2 ? "Lettuce" : "Tomato");
+            if (plant) {
+                delete plant;
+                sold++;
+            }
+            shared->getPlantCount("Tomato");
+            shared->getSlot(sold % 64);
+        }
+        harvester.join();
+
+        // The counts match the stacks, and nothing was lost or made up
+        int tomatoes = 0, lettuce = 0;
+        for (size_t i = 0; i < shared->getStackCount(); i++) {
+            InventorySlot slot = shared->getSlot(i);
+            if (slot.getPlantTypeId() == PlantTypes::TOMATO)
+                tomatoes += slot.getSize();
+            else if (slot.getPlantTypeId() == PlantTypes::LETTUCE)
+                lettuce += slot.getSize();
+        }
+        CHECK(shared->getPlantCount("Tomato") == tomatoes);
+        CHECK(shared->getPlantCount("Lettuce") == lettuce);
+        CHECK(tomatoes + lettuce + sold == 2 * perType);
+
+        // And the stacks are still found through the index
+        while (Plant *plant = shared->removeItem("Tomato"))
+            delete plant;
+        CHECK(shared->getPlantCount("Tomato") == 0);
+        delete shared;
+    }
+
+    SUBCASE("Swap between inventories") {
+        Inventory *other = new Inventory(4);
+        inv->add(new Lettuce(nullptr));
+        other->add(new Tomato(nullptr));
+        other->add(new Carrot(nullptr));
+
+        Inventory::swapBetweenInventories(inv, 0, other, 1);
+        CHECK(inv->getPlantCount("Carrot") == 1);
+        CHECK(inv->getPlantCount("Lettuce") == 0);
+        CHECK(other->getPlantCount("Lettuce") == 1);
+        CHECK(other->getPlantCount("Carrot") == 0);
+
+        other->add(new Lettuce(nullptr));
+        CHECK(other->getSlot(1).getSize() == 2);
+        delete other;
+    }
+
+    delete inv;
+}
+
+TEST_CASE("Inventory - Counted Stacks") {
+    Inventory *inv = new Inventory(4);
+    PlantTypeId tomato = PlantTypes::intern("Tomato");
+
+    SUBCASE("Bulk add spills into new stacks") {
+        CHECK(inv->add(tomato, 150) == 150);
+        CHECK(inv->getSlot(0).getSize() == 64);
+        CHECK(inv->getSlot(1).getSize() == 64);
+        CHECK(inv->getSlot(2).getSize() == 22);
+
+        // Only what fits is taken
+        CHECK(inv->add(tomato, 200) == 106);
+        CHECK(inv->isFull());
+        CHECK(inv->getPlantCount("Tomato") == 256);
+    }
+
+    SUBCASE("Items come back out as ripe plants") {
+        inv->add(new Tomato(nullptr));
+        Plant *plant = inv->removeItem("Tomato");
+        REQUIRE(plant != nullptr);
+        CHECK(plant->getType() == "Tomato");
+        CHECK(plant->isRipe());
+        CHECK(plant->getSellPrice() == 55.0f);
+        CHECK(inv->getSlot(0).isEmpty());
+        delete plant;
+    }
+
+    SUBCASE("Merging stacks") {
+        inv->addToSpecificSlot(tomato, 60, 0);
+        inv->addToSpecificSlot(tomato, 10, 2);
+        CHECK(inv->mergeSlots(2, 0) == 4);
+        CHECK(inv->getSlot(0).getSize() == 64);
+        CHECK(inv->getSlot(2).getSize() == 6);
+        CHECK(inv->getPlantCount("Tomato") == 70);
+
+        inv->add(new Lettuce(nullptr));
+        CHECK(inv->mergeSlots(1, 2) == 0);
+
+        // A stack that moves completely frees its slot
+        delete inv->removeItem("Tomato");
+        CHECK(inv->mergeSlots(2, 0) == 1);
+        CHECK(inv->mergeSlots(2, 3) == 0);
+    }
+
+    SUBCASE("Loads version 2 stacks with per-item records") {
+        BinaryWriter out;
+        out.writeU8(1);
+        out.writeName("Tomato");
+        out.writeU16(1);       // stacks
+        out.writeU16(2);       // slot
+        out.writeU8(0);        // type
+        out.writeU16(3);       // items
+        for (int i = 0; i < 3; i++) {
+            out.writeU8((uint8_t)PlantStage::Ripe);
+            out.writeFixed16(100.0f);
+            out.writeFixed16(50.0f);
+            out.writeFixed16(50.0f);
+        }
+        Serializer::deserializeInventory(inv, BinaryReader(out.getData()), 2);
+        REQUIRE(!inv->getSlot(2).isEmpty());
+        CHECK(inv->getSlot(2).getSize() == 3);
+        CHECK(inv->getPlantCount("Tomato") == 3);
+    }
+
+    delete inv;
+}
+
+TEST_CASE("PlantTypes - Registry") {
+    SUBCASE("Built-in crops have fixed ids") {
+        CHECK(PlantTypes::builtIn("Tomato") == PlantTypes::TOMATO);
+        CHECK(PlantTypes::find("Corn") == PlantTypes::CORN);
+        CHECK(PlantTypes::builtIn("Tomat") == PlantTypes::NONE);
+        REQUIRE(PlantTypes::describe(PlantTypes::TOMATO) != nullptr);
+        CHECK(PlantTypes::describe(PlantTypes::TOMATO)->sellPrice == 55.0f);
+        CHECK(PlantTypes::describe(PlantTypes::NONE) == nullptr);
+
+        Plant *carrot = PlantTypes::create(PlantTypes::CARROT);
+        REQUIRE(carrot != nullptr);
+        CHECK(carrot->getType() == "Carrot");
+        CHECK(carrot->getBaseGrowthRate() == 1.4f);
+        CHECK(carrot->getSellPrice() == 25.0f);
+        delete carrot;
+
+        SeedAdapter seeds(PlantTypes::PUMPKIN);
+        CHECK(seeds.getPrice() == 200.0f);
+    }
+
+    SUBCASE("New crops come from data") {
+        const char *path = "test_plants.txt";
+        {
+            std::ofstream file(path);
+            file << "# name growth sell seed width height look\n";
+            file << "Radish 1.5 12 6 0.6 0.7 Carrot\n";
+            file << "not a crop\n";
+        }
+        CHECK(PlantTypes::loadFile(path) == 1);
+        std::remove(path);
+        CHECK(PlantTypes::loadFile(path) == -1);
+
+        const PlantTypeId radish = PlantTypes::find("Radish");
+        REQUIRE(radish != PlantTypes::NONE);
+        CHECK(radish >= PlantTypes::BUILT_IN_COUNT);
+        CHECK(PlantTypes::describe(radish)->look == PlantTypes::CARROT);
+        CHECK(SeedAdapter(radish).getPrice() == 6.0f);
+
+        Inventory *inv = new Inventory(4);
+        Greenhouse *gh = new Greenhouse(inv);
+        gh->addPlant(PlantTypes::create(radish), 3);
+        std::string data = Serializer::serializeGreenhouse(gh);
+
+        Inventory *inv2 = new Inventory(4);
+        Greenhouse *gh2 = new Greenhouse(inv2);
+        Serializer::deserializeGreenhouse(gh2, data);
+        REQUIRE(gh2->getPlant(3) != nullptr);
+        CHECK(gh2->getPlant(3)->getType() == "Radish");
+        CHECK(gh2->getPlant(3)->getSellPrice() == 12.0f);
+
+        delete gh2;
+        delete inv2;
+        delete gh;
+        delete inv;
+    }
+}
+
 // =============================================================================
 // GREENHOUSE TESTS
 // =============================================================================
@@ -370,6 +710,325 @@ TEST_CASE("Greenhouse - Tick All Plants") {
     delete inv;
 }
 
+TEST_CASE("Greenhouse - Growing Past One Chunk") {
+    Inventory *inv = new Inventory(10);
+    Greenhouse *gh = new Greenhouse(inv);
+
+    Plant *first = new Carrot(nullptr);
+    gh->addPlant(first, 3);
+    first->water(30.0f);
+
+    SUBCASE("Existing plots stay put while the greenhouse grows") {
+        CHECK(gh->increaseCapacity(2000 - gh->getCapacity()));
+        CHECK(gh->getCapacity() == 2000);
+        CHECK(gh->getPlant(3) == first);
+        CHECK(first->getWater() == doctest::Approx(100.0f));
+
+        Plant *far = new Carrot(nullptr);
+        CHECK(gh->addPlant(far, 1999));
+        CHECK(gh->getPlant(1999) == far);
+        CHECK(gh->resolve(gh->getHandle(1999)) == far);
+    }
+
+    SUBCASE("Ticks reach plots in every chunk alike") {
+        gh->increaseCapacity(Greenhouse::PLOTS_PER_CHUNK * 3 - gh->getCapacity());
+        Plant *mid = new Carrot(nullptr);
+        Plant *last = new Carrot(nullptr);
+        gh->addPlant(mid, Greenhouse::PLOTS_PER_CHUNK + 5);
+        gh->addPlant(last, Greenhouse::PLOTS_PER_CHUNK * 3 - 1);
+        mid->water(30.0f);
+        last->water(30.0f);
+
+        for (int i = 0; i < 20; i++) {
+            gh->tickAllPlants();
+        }
+        CHECK(first->getGrowth() > 0.0f);
+        CHECK(mid->getGrowth() == doctest::Approx(first->getGrowth()));
+        CHECK(last->getGrowth() == doctest::Approx(first->getGrowth()));
+        CHECK(last->getWater() == doctest::Approx(first->getWater()));
+    }
+
+    SUBCASE("Capacity is capped") {
+        CHECK_FALSE(gh->increaseCapacity(Greenhouse::MAX_CAPACITY));
+        CHECK(gh->increaseCapacity(Greenhouse::MAX_CAPACITY - gh->getCapacity()));
+        CHECK_FALSE(gh->increaseCapacity(1));
+    }
+
+    delete gh;
+    delete inv;
+}
+
+TEST_CASE("Greenhouse - Batched Tick Matches Plant Tick") {
+    Inventory *inv = new Inventory(10);
+    Greenhouse *gh = new Greenhouse(inv);
+
+    Plant *loose = new Carrot(nullptr);
+    Plant *planted = new Carrot(nullptr);
+    gh->addPlant(planted, 3);
+    CHECK(planted->isBound());
+    CHECK_FALSE(loose->isBound());
+
+    SUBCASE("Same growth, resources and stage") {
+        for (int i = 0; i < 80; i++) {
+            if (i % 10 == 0) {
+                loose->water(30.0f);
+                planted->water(30.0f);
+            }
+            loose->tick();
+            gh->tickAllPlants();
+
+            CHECK(planted->getGrowth() == doctest::Approx(loose->getGrowth()));
+            CHECK(planted->getWater() == doctest::Approx(loose->getWater()));
+            CHECK(planted->getNutrients() == doctest::Approx(loose->getNutrients()));
+            CHECK(planted->getState() == loose->getState());
+        }
+    }
+
+    SUBCASE("Harvested plant becomes an inventory item") {
+        for (int i = 0; i < 40; i++) {
+            planted->water(10.0f);
+            planted->fertilize(10.0f);
+            gh->tickAllPlants();
+        }
+
+        // The plant object is gone after this; only the count is kept
+        CHECK(gh->harvestPlant(3));
+        CHECK(gh->getPlant(3) == nullptr);
+        CHECK(inv->getPlantCount("Carrot") == 1);
+    }
+
+    delete loose;
+    delete gh;
+    delete inv;
+}
+
+TEST_CASE("PlantStore - Event-Driven Ticks") {
+    SUBCASE("Timer wheel fires on the scheduled tick") {
+        TimerWheel wheel;
+        const std::vector<uint32_t> ticks = {1, 5, 63, 64, 65, 4095, 4096, 5000, 262144, 300000};
+        for (int i = 0; i < (int)ticks.size(); i++)
+            wheel.schedule(i, ticks[i]);
+
+        std::vector<uint32_t> firedAt(ticks.size(), 0);
+        std::vector<TimerWheel::Entry> due;
+        while (wheel.getNow() < 300000) {
+            due.clear();
+            wheel.advance(due);
+            for (const auto &entry : due)
+                firedAt[entry.id] = wheel.getNow();
+        }
+        CHECK(firedAt == ticks);
+
+        // Already past: next tick
+        wheel.schedule(7, 10);
+        due.clear();
+        wheel.advance(due);
+        REQUIRE(due.size() == 1);
+        CHECK(due[0].id == 7);
+    }
+
+    SUBCASE("Timer wheel skips to the next busy tick") {
+        TimerWheel wheel;
+        const std::vector<uint32_t> ticks = {5, 4096, 300000};
+        for (int i = 0; i < (int)ticks.size(); i++)
+            wheel.schedule(i, ticks[i]);
+
+        std::vector<TimerWheel::Entry> due;
+        std::vector<uint32_t> stops;
+        while (wheel.getNow() < 400000) {
+            due.clear();
+            wheel.advanceUntil(400000, due);
+            stops.push_back(wheel.getNow());
+        }
+        CHECK(stops == std::vector<uint32_t>{5, 4096, 300000, 400000});
+    }
+
+    PlantStore store(PlantStore::CHUNK_SIZE);
+    std::vector<int> woken;
+    auto tick = [&]() {
+        store.advance(woken);
+        for (int slot : woken)
+            store.wake(slot);
+        return (int)woken.size();
+    };
+
+    SUBCASE("Events match stepping tick by tick") {
+        Plant *planted = new Carrot(nullptr);
+        Plant *loose = new Carrot(nullptr);
+        store.bind(5, planted);
+
+        int wakes = 0;
+        for (int i = 0; i < 300; i++) {
+            wakes += tick();
+            loose->tick();
+            CHECK(planted->getState() == loose->getState());
+            CHECK(planted->getGrowth() == doctest::Approx(loose->getGrowth()));
+            CHECK(planted->getWater() == doctest::Approx(loose->getWater()));
+        }
+        // Sprouting, ripening, the two thresholds and death: nothing else
+        CHECK(planted->isDead());
+        CHECK(wakes <= 6);
+
+        delete planted;
+        delete loose;
+    }
+
+    SUBCASE("Idle plots aren't touched") {
+        std::vector<Plant *> plants;
+        for (int i = 0; i < PlantStore::CHUNK_SIZE; i++) {
+            plants.push_back(new Carrot(nullptr));
+            store.bind(i, plants.back());
+        }
+        for (int i = 0; i < 10; i++)
+            CHECK(tick() == 0);
+        CHECK(plants[0]->getWater() == doctest::Approx(90.0f));
+
+        for (Plant *plant : plants)
+            delete plant;
+    }
+
+    SUBCASE("Watering puts the next event back") {
+        Plant *plant = new Carrot(nullptr);
+        plant->setState(PlantState(0.0f, 25.0f, 100.0f, PlantStage::Seed));
+        store.bind(0, plant);
+        uint32_t thirsty = store.getNextEvent(0);
+        CHECK(thirsty == store.getNow() + 5);
+
+        plant->water(50.0f);
+        CHECK(store.getNextEvent(0) > thirsty);
+        // The old wake-up still comes, finds nothing due and books the new one
+        for (uint32_t t = store.getNow(); t < thirsty; t++)
+            tick();
+        CHECK(plant->getWater() > PlantStore::NEEDS_WATER_AT);
+        CHECK(store.takeCrossings(0) == 0);
+
+        delete plant;
+    }
+}
+
+// Collects the plot events a greenhouse publishes
+class RecordingObserver : public Observer {
+public:
+    void update() override { updates++; }
+    void setSubject(Greenhouse *) override {}
+    void onPlotEvents(const std::vector<PlotEvent> &published) override {
+        events.insert(events.end(), published.begin(), published.end());
+    }
+    int count(PlotEventType type) const {
+        int n = 0;
+        for (const auto &e : events) if (e.type == type) n++;
+        return n;
+    }
+    std::vector<PlotEvent> events;
+    int updates = 0;
+};
+
+TEST_CASE("Greenhouse - Plot Events") {
+    Inventory *inv = new Inventory(10);
+    Greenhouse *gh = new Greenhouse(inv);
+    RecordingObserver observer;
+
+    Plant *plant = new Tomato(nullptr);
+    plant->setState(PlantState(10.0f, 21.0f, 100.0f, PlantStage::Seed));
+    gh->addPlant(plant, 4);
+    gh->attach(&observer);
+    CHECK(observer.events.empty());
+
+    SUBCASE("Crossing a threshold publishes one event") {
+        gh->tickAllPlants();
+        REQUIRE(observer.count(PlotEventType::NeedsWater) == 1);
+        CHECK(observer.events[0].plot.index == 4);
+        CHECK(gh->resolve(observer.events[0].plot) == plant);
+
+        gh->tickAllPlants();
+        CHECK(observer.count(PlotEventType::NeedsWater) == 1);
+        CHECK(observer.updates == 0);
+    }
+
+    SUBCASE("Ripening publishes an event") {
+        plant->setState(PlantState(100.0f, 90.0f, 90.0f, PlantStage::Growing));
+        gh->tickAllPlants();
+        CHECK(observer.count(PlotEventType::Ripe) == 1);
+    }
+
+    SUBCASE("Attaching resyncs current needs") {
+        gh->tickAllPlants();
+        RecordingObserver late;
+        gh->attach(&late);
+        CHECK(late.count(PlotEventType::NeedsWater) == 1);
+        gh->detach(&late);
+    }
+
+    gh->detach(&observer);
+    delete gh;
+    delete inv;
+}
+
+TEST_CASE("Greenhouse - Fast Forward") {
+    // The same plots, one greenhouse stepped and one fast-forwarded
+    auto plantUp = [](Greenhouse *gh) {
+        for (int i = 0; i < 20; i++) {
+            Plant *plant = (i % 2 == 0) ? (Plant *)new Tomato(nullptr) : (Plant *)new Carrot(nullptr);
+            plant->setState(PlantState((float)i, 30.0f + 3.0f * i, 100.0f - 2.0f * i, PlantStage::Seed));
+            gh->addPlant(plant, i * 2);
+        }
+    };
+    Inventory *inv = new Inventory(10);
+    Greenhouse *stepped = new Greenhouse(inv);
+    Greenhouse *skipped = new Greenhouse(inv);
+    plantUp(stepped);
+    plantUp(skipped);
+    RecordingObserver steppedEvents;
+    RecordingObserver skippedEvents;
+    stepped->attach(&steppedEvents);
+    skipped->attach(&skippedEvents);
+
+    for (int t = 0; t < 400; t++)
+        stepped->tickAllPlants();
+    skipped->fastForward(400);
+
+    // Both run off the store's event lines, so they agree to the bit
+    for (int i = 0; i < 20; i++) {
+        Plant *a = stepped->getPlant(i * 2);
+        Plant *b = skipped->getPlant(i * 2);
+        CHECK(a->getState() == b->getState());
+        CHECK(a->getGrowth() == b->getGrowth());
+        CHECK(a->getWater() == b->getWater());
+        CHECK(a->getNutrients() == b->getNutrients());
+    }
+    CHECK_FALSE(steppedEvents.events.empty());
+    CHECK(steppedEvents.events.size() == skippedEvents.events.size());
+    CHECK(steppedEvents.count(PlotEventType::Ripe) == skippedEvents.count(PlotEventType::Ripe));
+
+    SUBCASE("Stops on the first tick with events") {
+        Plant *plant = new Tomato(nullptr);
+        plant->setState(PlantState(0.0f, 40.0f, 100.0f, PlantStage::Seed));
+        skipped->addPlant(plant, 50);
+        // Water 40 -> 20 takes 20 ticks at a seed's 1 per tick
+        CHECK(skipped->tickUntilEvent(1000) <= 20);
+    }
+
+    SUBCASE("Loose plants follow the same rules") {
+        Plant *stepping = new Tomato(nullptr);
+        Plant *jumping = new Tomato(nullptr);
+        for (int t = 0; t < 150; t++)
+            stepping->tick();
+        jumping->fastForward(150);
+        CHECK(jumping->getState() == stepping->getState());
+        CHECK(jumping->getGrowth() == stepping->getGrowth());
+        CHECK(jumping->getWater() == stepping->getWater());
+        CHECK(jumping->getNutrients() == stepping->getNutrients());
+        delete stepping;
+        delete jumping;
+    }
+
+    stepped->detach(&steppedEvents);
+    skipped->detach(&skippedEvents);
+    delete stepped;
+    delete skipped;
+    delete inv;
+}
+
 // =============================================================================
 // WORKER TESTS
 // =============================================================================
@@ -401,10 +1060,140 @@ TEST_CASE("Worker - Commands") {
     delete inv;
 }
 
+// Appends its id to a shared log so tests can check execution order
+class RecordingCommand : public Command {
+public:
+    RecordingCommand(std::vector<int> *log, std::mutex *mtx, int id) : log(log), mtx(mtx), id(id) {}
+    void execute() override {
+        std::lock_guard<std::mutex> lock(*mtx);
+        log->push_back(id);
+    }
+    bool isPatrol() const override { return true; }
+private:
+    std::vector<int> *log;
+    std::mutex *mtx;
+    int id;
+};
+
+TEST_CASE("Worker - Shared Pool") {
+    WorkerPool *pool = WorkerPool::getInstance();
+    REQUIRE(pool->getThreadCount() >= 1);
+
+    SUBCASE("Commands of one worker run in order") {
+        std::vector<int> log;
+        std::mutex mtx;
+        Worker worker;
+        worker.setLevel(2);
+        for (int i = 0; i < 100; i++) {
+            worker.addCommand(new RecordingCommand(&log, &mtx, i));
+        }
+        pool->waitIdle();
+
+        REQUIRE(log.size() == 100);
+        for (int i = 0; i < 100; i++) {
+            CHECK(log[i] == i);
+        }
+    }
+
+    SUBCASE("Many workers share the pool threads") {
+        std::vector<int> log;
+        std::mutex mtx;
+        std::vector<Worker *> workers;
+        for (int w = 0; w < 50; w++) {
+            workers.push_back(new Worker());
+            workers.back()->setLevel(1 + w % 3);
+        }
+        for (int i = 0; i < 10; i++) {
+            for (int w = 0; w < 50; w++) {
+                workers[w]->addCommand(new RecordingCommand(&log, &mtx, w * 1000 + i));
+            }
+        }
+        pool->waitIdle();
+        CHECK(log.size() == 500);
+        CHECK(pool->getThreadCount() < 50);
+
+        // Per-worker order holds even though the batches interleave
+        std::vector<int> next(50, 0);
+        for (int entry : log) {
+            CHECK(entry % 1000 == next[entry / 1000]);
+            next[entry / 1000]++;
+        }
+
+        for (auto *worker : workers) {
+            delete worker;
+        }
+    }
+
+    SUBCASE("Stopped worker drops its queue") {
+        std::vector<int> log;
+        std::mutex mtx;
+        Worker *worker = new Worker();
+        worker->stop();
+        worker->addCommand(new RecordingCommand(&log, &mtx, 1));
+        pool->waitIdle();
+        CHECK(log.empty());
+        delete worker;
+    }
+}
+
 // =============================================================================
 // COMMAND TESTS
 // =============================================================================
 
+TEST_CASE("ObjectPool - Blocks Are Reused") {
+    Inventory *inv = new Inventory(10);
+    Greenhouse *gh = new Greenhouse(inv);
+
+    SUBCASE("Commands made and freed on one thread") {
+        for (int i = 0; i < 1000; i++)
+            delete new WaterCommand(PlotHandle(), gh);
+        PoolStats before = Command::poolStats();
+
+        for (int i = 0; i < 10000; i++)
+            delete new WaterCommand(PlotHandle(), gh);
+        PoolStats after = Command::poolStats();
+
+        CHECK(after.allocations - before.allocations == 10000);
+        CHECK(after.heapAllocations == before.heapAllocations);
+    }
+
+    SUBCASE("Commands made on one thread and freed on another") {
+        // The way workers use them: made on the game thread, freed on a pool thread
+        uint64_t heapAfterFirstRound = 0;
+        for (int round = 0; round < 20; round++) {
+            std::vector<Command *> made;
+            for (int i = 0; i < 1000; i++)
+                made.push_back(new HarvestCommand(PlotHandle(), gh));
+            std::thread freer([&made]() {
+                for (Command *command : made)
+                    delete command;
+            });
+            freer.join();
+            if (round == 0)
+                heapAfterFirstRound = Command::poolStats().heapAllocations;
+        }
+        CHECK(Command::poolStats().heapAllocations == heapAfterFirstRound);
+    }
+
+    SUBCASE("Plants and their growth cycles") {
+        for (int i = 0; i < 300; i++)
+            delete new Carrot(nullptr);
+        PoolStats plants = Plant::poolStats();
+
+        // The cycle lives inside the plant, so only the plant is allocated
+        for (int i = 0; i < 3000; i++) {
+            Plant *plant = new Carrot(nullptr);
+            plant->setGrowthCycle(BoostedGrowthCycle{});
+            delete plant;
+        }
+        CHECK(Plant::poolStats().heapAllocations == plants.heapAllocations);
+        CHECK(Plant::poolStats().live() == plants.live());
+    }
+
+    delete gh;
+    delete inv;
+}
+
 TEST_CASE("Commands - Execution") {
     Inventory *inv = new Inventory(10);
     Greenhouse *gh = new Greenhouse(inv);
@@ -419,6 +1208,69 @@ TEST_CASE("Commands - Execution") {
         CHECK(plant->getWater() >= waterBefore);
     }
 
+    SUBCASE("Stale command does not touch the replacement plant") {
+        int plot = gh->findPlant(plant);
+        WaterCommand waterCmd(gh->getHandle(plot), gh);
+        gh->removePlant(plot);
+
+        Plant *replacement = new Lettuce(nullptr);
+        gh->addPlant(replacement, plot);
+        float waterBefore = replacement->getWater();
+        waterCmd.execute();
+        CHECK(replacement->getWater() == waterBefore);
+    }
+
+    delete gh;
+    delete inv;
+}
+
+TEST_CASE("Greenhouse - Plot Handles") {
+    Inventory *inv = new Inventory(10);
+    Greenhouse *gh = new Greenhouse(inv);
+
+    Plant *plant = new Lettuce(nullptr);
+    gh->addPlant(plant, 2);
+    PlotHandle handle = gh->getHandle(2);
+
+    CHECK(gh->resolve(handle) == plant);
+    CHECK(gh->getHandle(plant) == handle);
+    CHECK(gh->findPlant(plant) == 2);
+
+    SUBCASE("Harvest invalidates the handle") {
+        CHECK(gh->harvestPlant(handle));
+        CHECK(gh->resolve(handle) == nullptr);
+        CHECK_FALSE(gh->harvestPlant(handle));
+        CHECK(inv->getPlantCount("Lettuce") == 1);
+    }
+
+    SUBCASE("Replanting invalidates the handle") {
+        gh->removePlant(2);
+        gh->addPlant(new Lettuce(nullptr), 2);
+        CHECK(gh->resolve(handle) == nullptr);
+        CHECK_FALSE(gh->isCurrent(handle));
+        CHECK(gh->resolve(gh->getHandle(2)) != nullptr);
+    }
+
+    SUBCASE("Snapshots copy the plant and go empty with the handle") {
+        plant->setState(PlantState(100.0f, 40.0f, 60.0f, PlantStage::Ripe));
+        PlotSnapshot snapshot = gh->inspect(handle);
+        CHECK(snapshot.getType() == "Lettuce");
+        CHECK(snapshot.isRipe());
+        CHECK(std::string(snapshot.getStateName()) == "Ripe");
+        CHECK(snapshot.water == 40.0f);
+        CHECK(snapshot.nutrients == 60.0f);
+
+        CHECK(gh->harvestPlant(handle));
+        CHECK(gh->inspect(handle).isEmpty());
+        // The copy outlives the plant it was taken from
+        CHECK(snapshot.growth == 100.0f);
+    }
+
+    SUBCASE("Out of range handles resolve to null") {
+        CHECK(gh->getHandle(-1).isNull());
+        CHECK(gh->resolve(gh->getHandle(gh->getCapacity())) == nullptr);
+    }
+
     delete gh;
     delete inv;
 }
@@ -545,6 +1397,386 @@ TEST_CASE("Memento - Save and Restore") {
     CHECK(player->getMinute() == 30);
 }
 
+TEST_CASE("Serializer - Binary Round Trip") {
+    Inventory *inv = new Inventory(25);
+    Greenhouse *gh = new Greenhouse(inv);
+
+    Plant *tomato = new Tomato(nullptr);
+    // 20.003 is not a multiple of 1/256: it only survives as a full float
+    tomato->setState(PlantState(42.5f, 20.003f, 61.0f, PlantStage::Growing));
+    gh->addPlant(tomato, 7);
+    gh->addPlant(new Corn(nullptr), 55);
+    inv->addToSpecificSlot(new Lettuce(nullptr), 3);
+    inv->addToSpecificSlot(new Lettuce(nullptr), 3);
+
+    std::string ghData = Serializer::serializeGreenhouse(gh);
+    std::string invData = Serializer::serializeInventory(inv);
+
+    SUBCASE("Greenhouse plots and state survive") {
+        Inventory *inv2 = new Inventory(25);
+        Greenhouse *gh2 = new Greenhouse(inv2);
+        Serializer::deserializeGreenhouse(gh2, ghData);
+
+        CHECK(gh2->getSize() == 2);
+        REQUIRE(gh2->getPlant(7) != nullptr);
+        CHECK(gh2->getPlant(7)->getType() == "Tomato");
+        CHECK(gh2->getPlant(7)->getGrowth() == 42.5f);
+        CHECK(gh2->getPlant(7)->getWater() == 20.003f);
+        CHECK(gh2->getPlant(7)->getNutrients() == 61.0f);
+        CHECK(std::string(gh2->getPlant(7)->getStateName()) == "Growing");
+        REQUIRE(gh2->getPlant(55) != nullptr);
+        CHECK(gh2->getPlant(55)->getType() == "Corn");
+
+        delete gh2;
+        delete inv2;
+    }
+
+    SUBCASE("Inventory stacks keep their slots") {
+        Inventory *inv2 = new Inventory(25);
+        Serializer::deserializeInventory(inv2, invData);
+
+        REQUIRE(!inv2->getSlot(3).isEmpty());
+        CHECK(inv2->getSlot(3).getSize() == 2);
+        CHECK(inv2->getPlantCount("Lettuce") == 2);
+        delete inv2;
+    }
+
+    SUBCASE("Version 3 plots load from 8.8 fixed point") {
+        BinaryWriter out;
+        out.writeU8(1);
+        out.writeName("Tomato");
+        out.writeU16(56);      // capacity
+        out.writeU16(1);       // planted
+        out.writeU16(7);       // plot
+        out.writeU8(0);        // type
+        out.writeU8((uint8_t)PlantStage::Growing);
+        out.writeFixed16(42.5f);
+        out.writeFixed16(33.0f);
+        out.writeFixed16(61.0f);
+
+        Inventory *inv2 = new Inventory(25);
+        Greenhouse *gh2 = new Greenhouse(inv2);
+        Serializer::deserializeGreenhouse(gh2, BinaryReader(out.getData()), 3);
+        REQUIRE(gh2->getPlant(7) != nullptr);
+        CHECK(gh2->getPlant(7)->getGrowth() == 42.5f);
+        CHECK(gh2->getPlant(7)->getWater() == 33.0f);
+        CHECK(gh2->getPlant(7)->getNutrients() == 61.0f);
+        delete gh2;
+        delete inv2;
+    }
+
+    SUBCASE("Truncated data loads what it can without crashing") {
+        Inventory *inv2 = new Inventory(25);
+        Greenhouse *gh2 = new Greenhouse(inv2);
+        Serializer::deserializeGreenhouse(gh2, ghData.substr(0, ghData.size() - 5));
+        CHECK(gh2->getSize() == 1);
+        delete gh2;
+        delete inv2;
+    }
+
+    SUBCASE("Binary is smaller than the old text format") {
+        // The text format spent ~40 bytes per plant; binary spends 16 plus a ~70 byte type table
+        CHECK(ghData.size() < 200);
+    }
+
+    delete gh;
+    delete inv;
+}
+
+TEST_CASE("Serializer - Delta Mementos") {
+    SUBCASE("Greenhouse and inventory track what changed") {
+        Inventory *inv = new Inventory(25);
+        Greenhouse *gh = new Greenhouse(inv);
+        gh->addPlant(new Tomato(nullptr), 2);
+        gh->addPlant(new Corn(nullptr), 9);
+        inv->addToSpecificSlot(new Lettuce(nullptr), 4);
+
+        CHECK(gh->takeDirtyPlots() == std::vector<int>{2, 9});
+        CHECK(gh->takeDirtyPlots().empty());
+        CHECK(inv->takeDirtySlots() == std::vector<int>{4});
+        CHECK(inv->takeDirtySlots().empty());
+
+        gh->withPlant(gh->getHandle(9), [](Plant *plant) { plant->water(10.0f); });
+        gh->harvestPlant(2);
+        CHECK(gh->takeDirtyPlots() == std::vector<int>{2, 9});
+        CHECK_FALSE(inv->takeDirtySlots().empty());
+
+        delete gh;
+        delete inv;
+    }
+
+    SUBCASE("Inventory deltas taken during harvests lose nothing") {
+        Inventory *inv = new Inventory(25);
+        Inventory *replayed = new Inventory(25);
+        const int harvests = 1200;   // fits in the 25 slots
+        std::thread harvester([inv]() {
+            for (int i = 0; i < harvests; i++)
+                inv->add(i % 3 ? PlantTypes::TOMATO : PlantTypes::CARROT, 1);
+        });
+
+        // Journal deltas while the harvests land, then one more at the end
+        bool done = false;
+        while (!done) {
+            done = inv->getPlantCount("Tomato") + inv->getPlantCount("Carrot") == harvests;
+            std::vector<std::pair<int, InventorySlot>> stacks = inv->takeDirtyStacks();
+            std::string data = Serializer::serializeInventory(inv, &stacks);
+            Serializer::applyInventoryDelta(replayed, BinaryReader(data));
+        }
+        harvester.join();
+
+        CHECK(replayed->getPlantCount("Tomato") == inv->getPlantCount("Tomato"));
+        CHECK(replayed->getPlantCount("Carrot") == inv->getPlantCount("Carrot"));
+        CHECK(replayed->getPlantCount("Tomato") + replayed->getPlantCount("Carrot") == harvests);
+        delete replayed;
+        delete inv;
+    }
+
+    SUBCASE("Checkpoint plus delta rebuilds the same farm") {
+        Player player;
+        player.getPlot()->addPlant(new Tomato(nullptr), 1);
+        player.getPlot()->addPlant(new Corn(nullptr), 5);
+        player.getPlot()->addPlant(new Pepper(nullptr), 6);
+        Memento *checkpoint = player.createCheckpoint();
+
+        player.getPlot()->harvestPlant(5);
+        player.getPlot()->addPlant(new Lettuce(nullptr), 3);
+        player.getPlot()->withPlant(player.getPlot()->getHandle(6), [](Plant *plant) { plant->water(25.0f); });
+        Memento *delta = player.createDeltaMemento();
+        Memento *full = player.createMemento();
+
+        CHECK(delta->isDelta());
+        CHECK(delta->getGreenhouseData().size() < full->getGreenhouseData().size());
+
+        Player restored;
+        restored.setMemento(checkpoint);
+        restored.setMemento(delta);
+        Greenhouse *gh = restored.getPlot();
+        CHECK(gh->getSize() == 3);
+        CHECK(gh->getPlant(5) == nullptr);
+        REQUIRE(gh->getPlant(3) != nullptr);
+        CHECK(gh->getPlant(3)->getType() == "Lettuce");
+        REQUIRE(gh->getPlant(6) != nullptr);
+        CHECK(gh->getPlant(6)->getWater() == doctest::Approx(player.getPlot()->getPlant(6)->getWater()).epsilon(0.01));
+        CHECK(restored.getInventory()->getPlantCount("Corn") == 1);
+
+        delete checkpoint;
+        delete delta;
+        delete full;
+    }
+}
+
+TEST_CASE("Caretaker - Binary File and Legacy Text") {
+    const std::string path = "caretaker_test.sav";
+    const std::string legacyPath = "caretaker_test.txt";
+    std::remove(path.c_str());
+    std::remove(legacyPath.c_str());
+
+    SUBCASE("Binary file round trip") {
+        {
+            Caretaker caretaker(path);
+            caretaker.addMemento(new Memento("inv", "work", "gh", 12.5f, 3, 4, 15, 45));
+        }
+        Caretaker reloaded(path);
+        REQUIRE(reloaded.getMemento() != nullptr);
+        CHECK(reloaded.getMemento()->getFormat() == SaveFormat::VERSION);
+        CHECK(reloaded.getMemento()->getMoney() == 12.5f);
+        CHECK(reloaded.getMemento()->getDay() == 4);
+        CHECK(reloaded.getMemento()->getMinute() == 45);
+        CHECK(reloaded.getMemento()->getGreenhouseData() == "gh");
+    }
+
+    SUBCASE("Mapped save reads sections in place") {
+        {
+            Caretaker caretaker(path);
+            caretaker.addMemento(new Memento("inventory bytes", "work", "greenhouse bytes", 1.0f, 1, 2, 3, 4));
+        }
+        Caretaker reloaded(path);
+        REQUIRE(reloaded.getMemento() != nullptr);
+        Memento *mapped = reloaded.getMemento();
+        BinaryReader gh = mapped->readGreenhouse();
+        CHECK(std::string(gh.position(), gh.remaining()) == "greenhouse bytes");
+
+        // A newer save is renamed over the file; the open mapping keeps the old one
+        Caretaker writer(path);
+        writer.addMemento(new Memento("newer", "work", "gh", 9.0f, 1, 2, 3, 4));
+        writer.waitForSave();
+        CHECK(mapped->getInventoryData() == "inventory bytes");
+
+        // A copy (what the save thread gets) shares the mapping
+        Memento copy(*mapped);
+        CHECK(copy.getGreenhouseData() == "greenhouse bytes");
+        CHECK(copy.getDay() == 2);
+    }
+
+    SUBCASE("Old text save is picked up next to the binary path") {
+        {
+            std::ofstream legacy(legacyPath);
+            legacy << "INVENTORY:Lettuce|1.6|15|Seed|0|100|100\n";
+            legacy << "GREENHOUSE:1,56|Tomato|1.6|15|Growing|20|50|50\n";
+            legacy << "WORKERS:Water Worker\n";
+            legacy << "MONEY:77\nRATING:2\nDAY:3\nHOUR:9\nMINUTE:5\n";
+        }
+        Caretaker caretaker(path);
+        REQUIRE(caretaker.getMemento() != nullptr);
+        CHECK(caretaker.getMemento()->getFormat() == SaveFormat::LEGACY_TEXT);
+
+        Player player;
+        player.setMemento(caretaker.getMemento());
+        CHECK(player.getMoney() == 77.0f);
+        CHECK(player.getInventory()->getPlantCount("Lettuce") == 1);
+        REQUIRE(player.getPlot()->getPlant(0) != nullptr);
+        CHECK(player.getPlot()->getPlant(0)->getType() == "Tomato");
+    }
+
+    std::remove(path.c_str());
+    std::remove(legacyPath.c_str());
+}
+
+TEST_CASE("Caretaker - Async Save") {
+    const std::string path = "caretaker_async.sav";
+    std::remove(path.c_str());
+
+    SUBCASE("Write lands atomically and reports back") {
+        Caretaker caretaker(path);
+        CHECK(caretaker.getSaveStatus() == SaveStatus::Idle);
+
+        caretaker.addMemento(new Memento("inv", "work", "gh", 1.0f, 1, 1, 8, 0));
+        caretaker.addMemento(new Memento("inv", "work", "gh", 2.0f, 1, 2, 8, 0));
+        caretaker.waitForSave();
+
+        CHECK(caretaker.getSaveStatus() == SaveStatus::Saved);
+        CHECK(caretaker.getSaveCount() >= 1);
+        CHECK(std::filesystem::exists(path));
+        CHECK_FALSE(std::filesystem::exists(path + ".tmp"));
+
+        // The newest snapshot wins even if the first was never written
+        Caretaker reloaded(path);
+        REQUIRE(reloaded.getMemento() != nullptr);
+        CHECK(reloaded.getMemento()->getMoney() == 2.0f);
+    }
+
+    SUBCASE("Unwritable path reports failure") {
+        Caretaker caretaker("no_such_dir/caretaker_async.sav");
+        caretaker.addMemento(new Memento("inv", "work", "gh", 1.0f, 1, 1, 8, 0));
+        caretaker.waitForSave();
+        CHECK(caretaker.getSaveStatus() == SaveStatus::Failed);
+        // The snapshot is still kept in memory
+        CHECK(caretaker.getMemento() != nullptr);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Caretaker - Slots and Autosave Ring") {
+    std::filesystem::create_directory("caretaker_slots");
+    const std::string path = "caretaker_slots/game.sav";
+
+    SUBCASE("Named slots and autosaves are listed from their headers") {
+        Caretaker caretaker(path);
+        CHECK(caretaker.saveToSlot("farm", new Memento("inv", "work", "gh", 50.0f, 1, 3, 10, 30)));
+        CHECK_FALSE(caretaker.saveToSlot("../escape", new Memento("inv", "work", "gh", 1.0f, 1, 1, 0, 0)));
+        CHECK_FALSE(caretaker.saveToSlot("auto1", new Memento("inv", "work", "gh", 1.0f, 1, 1, 0, 0)));
+        caretaker.autosave(new Memento("inv", "work", "gh", 60.0f, 1, 4, 8, 0));
+        caretaker.waitForSave();
+
+        std::vector<SaveSlotInfo> slots = caretaker.listSlots();
+        REQUIRE(slots.size() == 2);
+        bool sawFarm = false, sawAuto = false;
+        for (const SaveSlotInfo& slot : slots) {
+            if (slot.name == "farm") {
+                sawFarm = true;
+                CHECK_FALSE(slot.autosave);
+                CHECK(slot.day == 3);
+                CHECK(slot.hour == 10);
+                CHECK(slot.money == 50.0f);
+                CHECK(slot.plants == 0);
+                CHECK(slot.savedAt > 0);
+            } else if (slot.name == "auto1") {
+                sawAuto = true;
+                CHECK(slot.autosave);
+                CHECK(slot.day == 4);
+            }
+        }
+        CHECK(sawFarm);
+        CHECK(sawAuto);
+
+        CHECK(caretaker.loadSlot("farm"));
+        CHECK(caretaker.getMemento()->getMoney() == 50.0f);
+        CHECK_FALSE(caretaker.loadSlot("missing"));
+    }
+
+    SUBCASE("Autosaves wrap around the ring") {
+        Caretaker caretaker(path);
+        for (int i = 0; i < Caretaker::AUTOSAVE_SLOTS + 2; i++) {
+            caretaker.autosave(new Memento("inv", "work", "gh", (float)i, 1, i, 0, 0));
+            caretaker.waitForSave();
+        }
+
+        int autosaves = 0;
+        for (const SaveSlotInfo& slot : caretaker.listSlots()) {
+            if (slot.autosave)
+                autosaves++;
+        }
+        CHECK(autosaves == Caretaker::AUTOSAVE_SLOTS);
+        // The two oldest were overwritten by the newest
+        REQUIRE(caretaker.loadSlot("auto1"));
+        CHECK(caretaker.getMemento()->getDay() == Caretaker::AUTOSAVE_SLOTS);
+        REQUIRE(caretaker.loadSlot("auto3"));
+        CHECK(caretaker.getMemento()->getDay() == 2);
+    }
+
+    SUBCASE("Deltas are journaled after the newest checkpoint") {
+        Caretaker caretaker(path);
+        CHECK_FALSE(caretaker.appendDelta(new Memento("", "", "", 1.0f, 1, 1, 0, 0, SaveFormat::VERSION, true)));
+
+        caretaker.autosave(new Memento("", "", "", 1.0f, 1, 1, 0, 0));
+        CHECK(caretaker.appendDelta(new Memento("", "", "", 2.0f, 1, 1, 1, 0, SaveFormat::VERSION, true)));
+        CHECK(caretaker.appendDelta(new Memento("", "", "", 3.0f, 1, 1, 2, 0, SaveFormat::VERSION, true)));
+        caretaker.waitForSave();
+
+        std::vector<SaveSlotInfo> slots = caretaker.listSlots();
+        REQUIRE(slots.size() == 1);
+        std::vector<Memento *> deltas = caretaker.readJournal(slots[0].checksum);
+        REQUIRE(deltas.size() == 2);
+        CHECK(deltas[0]->isDelta());
+        CHECK(deltas[0]->getMoney() == 2.0f);
+        CHECK(deltas[1]->getHour() == 2);
+        for (Memento *delta : deltas)
+            delete delta;
+
+        // A torn append from a crash is dropped, the rest still replays
+        {
+            std::ofstream journal(caretaker.journalPath(), std::ios::binary | std::ios::app);
+            journal << "\x40\x00\x00\x00partial";
+        }
+        deltas = caretaker.readJournal(slots[0].checksum);
+        CHECK(deltas.size() == 2);
+        for (Memento *delta : deltas)
+            delete delta;
+
+        // Not this journal's checkpoint
+        CHECK(caretaker.readJournal(slots[0].checksum + 1).empty());
+    }
+
+    SUBCASE("Corrupted save fails its checksum") {
+        {
+            Caretaker caretaker(path);
+            caretaker.addMemento(new Memento("inv", "work", "gh", 5.0f, 1, 1, 0, 0));
+        }
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(-1, std::ios::end);
+            file.put('X');
+        }
+        Caretaker reloaded(path);
+        CHECK(reloaded.getMemento() == nullptr);
+        // The header is still readable for the menu
+        CHECK(reloaded.listSlots().size() == 1);
+    }
+
+    std::filesystem::remove_all("caretaker_slots");
+}
+
 // =============================================================================
 // PLAYER TESTS
 // =============================================================================
@@ -630,6 +1862,171 @@ TEST_CASE("Player - Rating System") {
     }
 }
 
+// =============================================================================
+// SIMULATION ENGINE TESTS
+// =============================================================================
+
+TEST_CASE("SimulationEngine - Fixed Timestep") {
+    Player player;
+    player.setTime(1, 12, 0);
+    SimulationEngine engine(&player);
+
+    Plant *plant = new Tomato(nullptr);
+    player.getPlot()->addPlant(plant, 0);
+
+    SUBCASE("Real-time update runs due ticks") {
+        engine.update(1.0f);
+        CHECK(engine.getTickCount() == 2);
+        CHECK(player.getMinute() == 1);
+        CHECK(plant->getWater() < 100.0f);
+    }
+
+    SUBCASE("Night speed scales ticks with the clock") {
+        player.setTime(1, 22, 0);
+        engine.update(1.0f);
+        CHECK(engine.getTickCount() == 20);
+        CHECK(player.getMinute() == 10);
+    }
+
+    SUBCASE("A long frame drops the same time from clock and ticks") {
+        engine.update(500.0f);
+        CHECK(engine.getTickCount() == SimulationEngine::MAX_TICKS_PER_UPDATE);
+        CHECK(player.getHour() * 60 + player.getMinute() - 12 * 60 ==
+              SimulationEngine::MAX_TICKS_PER_UPDATE / SimulationEngine::TICKS_PER_GAME_MINUTE);
+
+        // Nothing left over to catch up on, and the two keep pace afterwards
+        engine.update(1.0f);
+        CHECK(engine.getTickCount() == SimulationEngine::MAX_TICKS_PER_UPDATE + 2);
+        CHECK(player.getHour() * 60 + player.getMinute() - 12 * 60 ==
+              (SimulationEngine::MAX_TICKS_PER_UPDATE + 2) / SimulationEngine::TICKS_PER_GAME_MINUTE);
+    }
+
+    SUBCASE("Paused engine does nothing") {
+        engine.setPaused(true);
+        engine.update(5.0f);
+        CHECK(engine.getTickCount() == 0);
+        CHECK(player.getMinute() == 0);
+    }
+
+    SUBCASE("Headless fast-forward") {
+        engine.runGameMinutes(60);
+        CHECK(engine.getTickCount() == 60 * SimulationEngine::TICKS_PER_GAME_MINUTE);
+        CHECK(player.getHour() == 13);
+    }
+
+    SUBCASE("Closed-form fast-forward lands where stepping does") {
+        Player other;
+        other.setTime(1, 12, 0);
+        SimulationEngine otherEngine(&other);
+        Plant *twin = new Tomato(nullptr);
+        other.getPlot()->addPlant(twin, 0);
+
+        engine.runGameMinutes(90);
+        otherEngine.fastForward(90);
+        CHECK(otherEngine.getTickCount() == engine.getTickCount());
+        CHECK(other.getHour() == player.getHour());
+        CHECK(other.getMinute() == player.getMinute());
+        CHECK(twin->getState() == plant->getState());
+        CHECK(twin->getGrowth() == plant->getGrowth());
+        CHECK(twin->getWater() == plant->getWater());
+    }
+
+    SUBCASE("Sleeping until morning") {
+        CHECK_FALSE(engine.isNight());
+        CHECK(engine.sleepUntilMorning() == 0);   // midday: nothing to skip
+        player.setTime(1, 22, 30);
+        CHECK(engine.isNight());
+        CHECK(engine.sleepUntilMorning() == 7 * 60 + 30);
+        CHECK_FALSE(engine.isNight());
+        CHECK(player.getDay() == 2);
+        CHECK(player.getHour() == 6);
+        CHECK(player.getMinute() == 0);
+        CHECK(engine.getTickCount() == (7 * 60 + 30) * SimulationEngine::TICKS_PER_GAME_MINUTE);
+    }
+}
+
+// =============================================================================
+// LOGGER TESTS
+// =============================================================================
+
+TEST_CASE("Logger - Buffered Output") {
+    const char *path = "logger_test.log";
+    std::remove(path);
+
+    Logger *logger = Logger::getInstance();
+    REQUIRE(logger->setOutputFile(path));
+    logger->setLevel(LogLevel::Info);
+
+    LOG_INFO("main thread %d", 1);
+    logger->log(LogLevel::Debug, "filtered at runtime");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 10; i++) {
+                LOG_WARN("worker %d message %d", t, i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    logger->flush();
+    logger->setOutputFile("");
+
+    std::ifstream in(path);
+    std::string line;
+    int lines = 0, warnings = 0;
+    bool sawDebug = false;
+    while (std::getline(in, line)) {
+        lines++;
+        if (line.find("WARN") != std::string::npos) warnings++;
+        if (line.find("filtered at runtime") != std::string::npos) sawDebug = true;
+    }
+    in.close();
+    std::remove(path);
+
+    CHECK(lines == 41);
+    CHECK(warnings == 40);
+    CHECK_FALSE(sawDebug);
+    CHECK(logger->getDroppedCount() == 0);
+}
+
+TEST_CASE("Logger - Planted Plants Log Like Loose Ones") {
+    const char *path = "logger_plot_test.log";
+    std::remove(path);
+
+    Logger *logger = Logger::getInstance();
+    REQUIRE(logger->setOutputFile(path));
+    logger->setLevel(LogLevel::Info);
+
+    Inventory *inv = new Inventory(4);
+    Greenhouse *gh = new Greenhouse(inv);
+    Plant *plant = new Tomato(nullptr);
+    plant->setState(PlantState(30.0f, 0.0f, 0.0f, PlantStage::Growing));
+    gh->addPlant(plant, 0);
+    for (int i = 0; i < 3; i++)
+        gh->tickAllPlants();
+    CHECK(plant->isDead());
+
+    logger->flush();
+    logger->setOutputFile("");
+
+    std::ifstream in(path);
+    std::string line;
+    int deaths = 0;
+    while (std::getline(in, line)) {
+        if (line.find("Plant died!") != std::string::npos) deaths++;
+    }
+    in.close();
+    std::remove(path);
+    CHECK(deaths == 1);
+
+    delete gh;
+    delete inv;
+}
+
 // =============================================================================
 // GAME TESTS
 // =============================================================================